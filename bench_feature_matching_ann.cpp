@@ -0,0 +1,186 @@
+#include <Eigen/Core>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tiny3d/geometry/KDTreeSearchParam.h"
+#include "tiny3d/geometry/PointCloud.h"
+#include "tiny3d/pipelines/registration/Feature.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using tiny3d::geometry::KDTreeSearchParamHybrid;
+using tiny3d::geometry::KDTreeSearchParamKNN;
+using tiny3d::geometry::PointCloud;
+using tiny3d::pipelines::registration::ComputeCorrespondenceFeatureDistances;
+using tiny3d::pipelines::registration::ComputeFPFHFeature;
+using tiny3d::pipelines::registration::CorrespondenceSet;
+using tiny3d::pipelines::registration::CorrespondencesFromFeatures;
+using tiny3d::pipelines::registration::Feature;
+using tiny3d::pipelines::registration::FeatureMatchingMethod;
+using tiny3d::pipelines::registration::FeatureMatchingOption;
+
+struct ScenarioConfig {
+    std::string name;
+    int seed = 7;
+    int n = 150;
+    double noise_std = 0.002;
+    double feature_radius = 0.08;
+    int feature_max_nn = 64;
+    int runs = 3;
+    bool brute_force = true;
+};
+
+struct ForestConfig {
+    int num_trees;
+    int max_checks;
+};
+
+template <typename Fn>
+double MeanMs(int runs, Fn &&fn) {
+    fn();
+    double total_ms = 0.0;
+    for (int i = 0; i < runs; ++i) {
+        const auto start = Clock::now();
+        fn();
+        const auto stop = Clock::now();
+        total_ms += std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+    return total_ms / static_cast<double>(runs);
+}
+
+/// Rough terrain with point jitter and noise, so that FPFH features spread
+/// over the feature space as on real scans.
+PointCloud MakeTerrain(const ScenarioConfig &config, std::mt19937 &rng) {
+    std::uniform_real_distribution<double> jitter(-0.15, 0.15);
+    std::normal_distribution<double> noise(0.0, config.noise_std);
+    PointCloud cloud;
+    cloud.points_.reserve(config.n * config.n);
+    for (int iy = 0; iy < config.n; ++iy) {
+        for (int ix = 0; ix < config.n; ++ix) {
+            const double x = -1.0 + (2.0 * ix + jitter(rng)) / (config.n - 1.0);
+            const double y = -1.0 + (2.0 * iy + jitter(rng)) / (config.n - 1.0);
+            const double z = 0.2 * std::sin(3.0 * x) * std::cos(2.0 * y) +
+                             0.05 * std::sin(11.0 * x + 3.0 * y) +
+                             0.03 * std::cos(17.0 * y - 5.0 * x);
+            cloud.points_.emplace_back(x + noise(rng), y + noise(rng),
+                                       z + noise(rng));
+        }
+    }
+    cloud.EstimateNormals(KDTreeSearchParamKNN(16));
+    return cloud;
+}
+
+void PrintMetric(const std::string &key, double value) {
+    std::cout << key << "=" << std::setprecision(6) << value << "\n";
+}
+
+void PrintMetric(const std::string &key, size_t value) {
+    std::cout << key << "=" << value << "\n";
+}
+
+/// Fraction of the approximate matches that are as close in feature space as
+/// the exact nearest neighbors, so that ties do not count as misses.
+double Recall(const Feature &source_feature,
+              const Feature &target_feature,
+              const CorrespondenceSet &exact,
+              const CorrespondenceSet &approximate) {
+    const std::vector<double> exact_distances =
+            ComputeCorrespondenceFeatureDistances(source_feature, target_feature,
+                                                  exact);
+    const std::vector<double> approximate_distances =
+            ComputeCorrespondenceFeatureDistances(source_feature, target_feature,
+                                                  approximate);
+    size_t found = 0;
+    for (size_t i = 0; i < exact.size() && i < approximate.size(); ++i) {
+        found += approximate_distances[i] <= exact_distances[i] * (1.0 + 1e-6)
+                         ? 1
+                         : 0;
+    }
+    return exact.empty() ? 1.0 : static_cast<double>(found) / exact.size();
+}
+
+void RunScenario(const ScenarioConfig &config,
+                 const std::vector<ForestConfig> &forest_configs) {
+    std::mt19937 rng(config.seed);
+    const PointCloud source = MakeTerrain(config, rng);
+    const PointCloud target = MakeTerrain(config, rng);
+
+    const KDTreeSearchParamHybrid feature_search(config.feature_radius,
+                                                 config.feature_max_nn);
+    const std::shared_ptr<Feature> source_feature =
+            ComputeFPFHFeature(source, feature_search);
+    const std::shared_ptr<Feature> target_feature =
+            ComputeFPFHFeature(target, feature_search);
+    PrintMetric(config.name + ".source_points", source.points_.size());
+    PrintMetric(config.name + ".target_points", target.points_.size());
+
+    CorrespondenceSet exact;
+    const double exact_ms = MeanMs(config.runs, [&]() {
+        exact = CorrespondencesFromFeatures(*source_feature, *target_feature,
+                                            false, 0.1f, FeatureMatchingOption());
+    });
+    PrintMetric(config.name + ".kdtree_mean_ms", exact_ms);
+
+    if (config.brute_force) {
+        CorrespondenceSet brute_force;
+        const double brute_force_ms = MeanMs(config.runs, [&]() {
+            brute_force = CorrespondencesFromFeatures(
+                    *source_feature, *target_feature, false, 0.1f,
+                    FeatureMatchingOption(FeatureMatchingMethod::BruteForce));
+        });
+        PrintMetric(config.name + ".brute_force_mean_ms", brute_force_ms);
+        PrintMetric(config.name + ".brute_force_speedup", exact_ms / brute_force_ms);
+        PrintMetric(config.name + ".brute_force_recall",
+                    Recall(*source_feature, *target_feature, exact, brute_force));
+    }
+
+    for (const ForestConfig &forest : forest_configs) {
+        const FeatureMatchingOption option(FeatureMatchingMethod::KDTreeForest,
+                                           forest.num_trees, forest.max_checks);
+        CorrespondenceSet approximate;
+        const double forest_ms = MeanMs(config.runs, [&]() {
+            approximate = CorrespondencesFromFeatures(
+                    *source_feature, *target_feature, false, 0.1f, option);
+        });
+        const std::string prefix = config.name + ".forest_t" +
+                                   std::to_string(forest.num_trees) + "_c" +
+                                   std::to_string(forest.max_checks);
+        PrintMetric(prefix + ".mean_ms", forest_ms);
+        PrintMetric(prefix + ".speedup", exact_ms / forest_ms);
+        PrintMetric(prefix + ".recall",
+                    Recall(*source_feature, *target_feature, exact, approximate));
+    }
+}
+
+}  // namespace
+
+int main() {
+    const std::vector<ForestConfig> forest_configs{
+            {1, 32}, {4, 64}, {4, 128}, {8, 256}};
+
+    ScenarioConfig medium;
+    medium.name = "medium";
+    medium.seed = 7;
+    medium.n = 150;
+    RunScenario(medium, forest_configs);
+
+    ScenarioConfig large;
+    large.name = "large";
+    large.seed = 11;
+    large.n = 450;
+    large.noise_std = 0.001;
+    large.feature_radius = 0.03;
+    large.runs = 1;
+    large.brute_force = false;
+    RunScenario(large, forest_configs);
+
+    return 0;
+}
@@ -16,6 +16,7 @@ function(tiny3d_print_configuration_summary)
     message(STATUS "================================================================================")
     message(STATUS "Enabled Features:")
     tiny3d_aligned_print("OpenMP" "${WITH_OPENMP}")
+    tiny3d_aligned_print("Feature Matching ISA" "${FEATURE_MATCHING_ISA}")
     tiny3d_aligned_print("SYCL Support" "${BUILD_SYCL_MODULE}")
     if(ENABLE_SYCL_UNIFIED_SHARED_MEMORY)
         tiny3d_aligned_print("SYCL unified shared memory" "${ENABLE_SYCL_UNIFIED_SHARED_MEMORY}")
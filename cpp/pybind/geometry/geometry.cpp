@@ -181,6 +181,7 @@ void pybind_geometry_declarations(py::module &m) {
     pybind_geometry_classes_declarations(m_geometry);
     pybind_kdtreeflann_declarations(m_geometry);
     pybind_pointcloud_declarations(m_geometry);
+    pybind_keypoint_declarations(m_geometry);
     pybind_voxelgrid_declarations(m_geometry);
     pybind_meshbase_declarations(m_geometry);
     pybind_trianglemesh_declarations(m_geometry);
@@ -192,6 +193,7 @@ void pybind_geometry_definitions(py::module &m) {
     pybind_geometry_classes_definitions(m_geometry);
     pybind_kdtreeflann_definitions(m_geometry);
     pybind_pointcloud_definitions(m_geometry);
+    pybind_keypoint_definitions(m_geometry);
     pybind_voxelgrid_definitions(m_geometry);
     pybind_meshbase_definitions(m_geometry);
     pybind_trianglemesh_definitions(m_geometry);
@@ -0,0 +1,51 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/geometry/Keypoint.h"
+
+#include "tiny3d/geometry/PointCloud.h"
+#include "pybind/docstring.h"
+#include "pybind/geometry/geometry.h"
+
+namespace tiny3d {
+namespace geometry {
+
+void pybind_keypoint_declarations(py::module &m) {
+    m.def_submodule("keypoint", "Keypoint Detectors.");
+}
+
+void pybind_keypoint_definitions(py::module &m) {
+    auto m_keypoint = static_cast<py::module>(m.attr("keypoint"));
+    m_keypoint.def("compute_iss_keypoints", &keypoint::ComputeISSKeypoints,
+                   "Function that computes the ISS keypoints of a point "
+                   "cloud and returns their indices",
+                   "input"_a, "salient_radius"_a = 0.0,
+                   "non_max_radius"_a = 0.0, "gamma_21"_a = 0.975,
+                   "gamma_32"_a = 0.975, "min_neighbors"_a = 5);
+    docstring::FunctionDocInject(
+            m_keypoint, "compute_iss_keypoints",
+            {{"input", "The input point cloud."},
+             {"salient_radius",
+              "The radius of the spherical neighborhood used to compute the "
+              "covariance of every point. If 0, 6 times the resolution of the "
+              "point cloud."},
+             {"non_max_radius",
+              "The radius of the non maximum suppression. If 0, 4 times the "
+              "resolution of the point cloud."},
+             {"gamma_21",
+              "The upper bound on the ratio between the second and the first "
+              "eigenvalue."},
+             {"gamma_32",
+              "The upper bound on the ratio between the third and the second "
+              "eigenvalue."},
+             {"min_neighbors",
+              "Minimum number of neighbors within salient_radius for a point "
+              "to be a keypoint."}});
+}
+
+}  // namespace geometry
+}  // namespace tiny3d
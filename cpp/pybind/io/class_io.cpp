@@ -9,9 +9,11 @@
 #include <unordered_map>
 
 
+#include "tiny3d/io/FeatureIO.h"
 #include "tiny3d/io/FileFormatIO.h"
 #include "tiny3d/io/ModelIO.h"
 #include "tiny3d/io/PointCloudIO.h"
+#include "tiny3d/io/PointCloudReader.h"
 #include "tiny3d/io/TriangleMeshIO.h"
 #include "pybind/docstring.h"
 #include "pybind/io/io.h"
@@ -37,6 +39,18 @@ static const std::unordered_map<std::string, std::string>
                  "If true, all points that include an infinite value are "
                  "removed from the PointCloud."},
                 {"quality", "Quality of the output file."},
+                {"write_float32",
+                 "Set to ``True`` to store point coordinates and normals in "
+                 "single precision. Only supported by PLY and T3D, and by "
+                 "features."},
+                {"write_checksum",
+                 "Set to ``True`` to store a checksum of the data, verified "
+                 "when reading. Only supported by T3D, and by features."},
+                {"precision",
+                 "Number of digits after the decimal point of the "
+                 "coordinates written by ASCII formats, or -1 for the "
+                 "shortest representation that reads back exactly. Only "
+                 "supported by XYZ, XYZN, XYZRGB and PTS."},
                 {"write_ascii",
                  "Set to ``True`` to output in ascii format, otherwise binary "
                  "format will be used."},
@@ -67,6 +81,11 @@ void pybind_class_io_declarations(py::module &m_io) {
             .value("CONTAINS_LINES", FileGeometry::CONTAINS_LINES)
             .value("CONTAINS_TRIANGLES", FileGeometry::CONTAINS_TRIANGLES)
             .export_values();
+    py::class_<PointCloudReader> pointcloud_reader(
+            m_io, "PointCloudReader",
+            "Reads the points of a point cloud file in chunks, to process "
+            "clouds that do not fit in memory. Supports XYZ, XYZN, XYZRGB and "
+            "PLY files.");
 }
 void pybind_class_io_definitions(py::module &m_io) {
     m_io.def(
@@ -124,15 +143,21 @@ void pybind_class_io_definitions(py::module &m_io) {
             "write_point_cloud",
             [](const fs::path &filename, const geometry::PointCloud &pointcloud,
                const std::string &format, bool write_ascii, bool compressed,
-               bool print_progress) {
+               bool print_progress, bool write_float32, int precision,
+               bool write_checksum) {
                 py::gil_scoped_release release;
-                return WritePointCloud(
-                        filename.string(), pointcloud,
-                        {format, write_ascii, compressed, print_progress});
+                WritePointCloudOption option(format, write_ascii, compressed,
+                                             print_progress);
+                option.write_float32 = write_float32;
+                option.precision = precision;
+                option.write_checksum = write_checksum;
+                return WritePointCloud(filename.string(), pointcloud, option);
             },
             "Function to write PointCloud to file", "filename"_a,
             "pointcloud"_a, "format"_a = "auto", "write_ascii"_a = false,
-            "compressed"_a = false, "print_progress"_a = false);
+            "compressed"_a = false, "print_progress"_a = false,
+            "write_float32"_a = false, "precision"_a = 10,
+            "write_checksum"_a = false);
     docstring::FunctionDocInject(m_io, "write_point_cloud",
                                  map_shared_argument_docstrings);
 
@@ -140,13 +165,17 @@ void pybind_class_io_definitions(py::module &m_io) {
             "write_point_cloud_to_bytes",
             [](const geometry::PointCloud &pointcloud,
                const std::string &format, bool write_ascii, bool compressed,
-               bool print_progress) {
+               bool print_progress, bool write_float32, int precision,
+               bool write_checksum) {
                 py::gil_scoped_release release;
                 size_t len = 0;
                 unsigned char *buffer = nullptr;
-                bool wrote = WritePointCloud(
-                        buffer, len, pointcloud,
-                        {format, write_ascii, compressed, print_progress});
+                WritePointCloudOption option(format, write_ascii, compressed,
+                                             print_progress);
+                option.write_float32 = write_float32;
+                option.precision = precision;
+                option.write_checksum = write_checksum;
+                bool wrote = WritePointCloud(buffer, len, pointcloud, option);
                 py::gil_scoped_acquire acquire;
                 if (!wrote) {
                     return py::bytes();
@@ -158,10 +187,59 @@ void pybind_class_io_definitions(py::module &m_io) {
             },
             "Function to write PointCloud to memory", "pointcloud"_a,
             "format"_a = "auto", "write_ascii"_a = false,
-            "compressed"_a = false, "print_progress"_a = false);
+            "compressed"_a = false, "print_progress"_a = false,
+            "write_float32"_a = false, "precision"_a = 10,
+            "write_checksum"_a = false);
     docstring::FunctionDocInject(m_io, "write_point_cloud_to_bytes",
                                  map_shared_argument_docstrings);
 
+    // tiny3d::io::PointCloudReader
+    auto pointcloud_reader = static_cast<py::class_<PointCloudReader>>(
+            m_io.attr("PointCloudReader"));
+    pointcloud_reader
+            .def_static(
+                    "open",
+                    [](const fs::path &filename, const std::string &format) {
+                        return PointCloudReader::Open(filename.string(),
+                                                      format);
+                    },
+                    "Opens a point cloud file for reading in chunks. Returns "
+                    "``None`` if the file cannot be opened or its format "
+                    "does not support reading in chunks.",
+                    "filename"_a, "format"_a = "auto")
+            .def("get_point_count", &PointCloudReader::GetPointCount,
+                 py::call_guard<py::gil_scoped_release>(),
+                 "Returns the number of points of the file. Formats without "
+                 "a point count scan the whole file on the first call.")
+            .def("seek", &PointCloudReader::Seek,
+                 py::call_guard<py::gil_scoped_release>(),
+                 "Moves to the point at ``index``. Returns ``False`` if it is "
+                 "out of range.",
+                 "index"_a)
+            .def("get_position", &PointCloudReader::GetPosition,
+                 "Returns the index of the next point to read.")
+            .def(
+                    "read_chunk",
+                    [](PointCloudReader &reader, int64_t max_points) {
+                        py::gil_scoped_release release;
+                        geometry::PointCloud chunk;
+                        reader.ReadChunk(max_points, chunk);
+                        return chunk;
+                    },
+                    "Reads the next points of the file, at most "
+                    "``max_points``. Returns an empty ``PointCloud`` when no "
+                    "points remain.",
+                    "max_points"_a);
+    docstring::ClassMethodDocInject(m_io, "PointCloudReader",
+                                    "get_point_count");
+    docstring::ClassMethodDocInject(m_io, "PointCloudReader", "get_position");
+    docstring::ClassMethodDocInject(m_io, "PointCloudReader", "seek",
+                                    {{"index", "Index of the next point to "
+                                               "read."}});
+    docstring::ClassMethodDocInject(
+            m_io, "PointCloudReader", "read_chunk",
+            {{"max_points", "Maximum number of points of the chunk."}});
+
     // tiny3d::geometry::TriangleMesh
     m_io.def(
             "read_triangle_mesh",
@@ -199,6 +277,77 @@ void pybind_class_io_definitions(py::module &m_io) {
     docstring::FunctionDocInject(m_io, "write_triangle_mesh",
                                  map_shared_argument_docstrings);
 
+    // tiny3d::pipelines::registration::Feature
+    m_io.def(
+            "read_feature",
+            [](const fs::path &filename) {
+                py::gil_scoped_release release;
+                pipelines::registration::Feature feature;
+                ReadFeature(filename.string(), feature);
+                return feature;
+            },
+            "Function to read registration.Feature from file", "filename"_a);
+    docstring::FunctionDocInject(m_io, "read_feature",
+                                 map_shared_argument_docstrings);
+
+    m_io.def(
+            "read_feature_from_bytes",
+            [](const py::bytes &bytes) {
+                const char *dataptr = PYBIND11_BYTES_AS_STRING(bytes.ptr());
+                auto length = PYBIND11_BYTES_SIZE(bytes.ptr());
+                auto buffer = new unsigned char[length];
+                // copy before releasing GIL
+                std::memcpy(buffer, dataptr, length);
+                py::gil_scoped_release release;
+                pipelines::registration::Feature feature;
+                ReadFeature(reinterpret_cast<const unsigned char *>(buffer),
+                            length, feature);
+                delete[] buffer;
+                return feature;
+            },
+            "Function to read registration.Feature from memory", "bytes"_a);
+    docstring::FunctionDocInject(m_io, "read_feature_from_bytes",
+                                 map_shared_argument_docstrings);
+
+    m_io.def(
+            "write_feature",
+            [](const fs::path &filename,
+               const pipelines::registration::Feature &feature,
+               bool write_float32, bool compressed, bool write_checksum) {
+                py::gil_scoped_release release;
+                return WriteFeature(filename.string(), feature, write_float32,
+                                    compressed, write_checksum);
+            },
+            "Function to write registration.Feature to file", "filename"_a,
+            "feature"_a, "write_float32"_a = false, "compressed"_a = false,
+            "write_checksum"_a = false);
+    docstring::FunctionDocInject(m_io, "write_feature",
+                                 map_shared_argument_docstrings);
+
+    m_io.def(
+            "write_feature_to_bytes",
+            [](const pipelines::registration::Feature &feature,
+               bool write_float32, bool compressed, bool write_checksum) {
+                py::gil_scoped_release release;
+                size_t len = 0;
+                unsigned char *buffer = nullptr;
+                bool wrote = WriteFeature(buffer, len, feature, write_float32,
+                                          compressed, write_checksum);
+                py::gil_scoped_acquire acquire;
+                if (!wrote) {
+                    return py::bytes();
+                }
+                auto ret =
+                        py::bytes(reinterpret_cast<const char *>(buffer), len);
+                delete[] buffer;
+                return ret;
+            },
+            "Function to write registration.Feature to memory", "feature"_a,
+            "write_float32"_a = false, "compressed"_a = false,
+            "write_checksum"_a = false);
+    docstring::FunctionDocInject(m_io, "write_feature_to_bytes",
+                                 map_shared_argument_docstrings);
+
 
 
 }
@@ -9,6 +9,7 @@
 
 #include "tiny3d/geometry/KDTreeSearchParam.h"
 #include "tiny3d/geometry/PointCloud.h"
+#include "tiny3d/utility/Logging.h"
 #include "pybind/docstring.h"
 #include "pybind/pipelines/registration/registration.h"
 
@@ -20,6 +21,28 @@ void pybind_feature_declarations(py::module &m_registration) {
     py::class_<Feature, std::shared_ptr<Feature>> feature(
             m_registration, "Feature",
             "Class to store featrues for registration.");
+    py::enum_<FeatureMatchingMethod> feature_matching_method(
+            m_registration, "FeatureMatchingMethod", py::arithmetic());
+    feature_matching_method.value("KDTree", FeatureMatchingMethod::KDTree)
+            .value("KDTreeForest", FeatureMatchingMethod::KDTreeForest)
+            .value("BruteForce", FeatureMatchingMethod::BruteForce)
+            .export_values();
+    feature_matching_method.attr("__doc__") = docstring::static_property(
+            py::cpp_function([](py::handle arg) -> std::string {
+                return "Enum class that selects the nearest neighbor search "
+                       "used to match features. ``KDTree`` searches exactly, "
+                       "``KDTreeForest`` searches approximately with a "
+                       "randomized KD-tree forest, ``BruteForce`` searches "
+                       "by brute force in single precision, exactly up to "
+                       "single precision rounding of the distances. Brute "
+                       "force only pays off for features of high intrinsic "
+                       "dimension; on FPFH features ``KDTree`` is faster.";
+            }),
+            py::none(), py::none(), "");
+    py::class_<FeatureMatchingOption> feature_matching_option(
+            m_registration, "FeatureMatchingOption",
+            "Options of the nearest neighbor search used for feature "
+            "matching.");
     m_registration.attr("m") =
             py::module_::import("typing").attr("TypeVar")("m");
     m_registration.attr("n") =
@@ -53,21 +76,76 @@ void pybind_feature_definitions(py::module &m_registration) {
     docstring::ClassMethodDocInject(m_registration, "Feature", "resize",
                                     {{"dim", "Feature dimension per point."},
                                      {"n", "Number of points."}});
-    m_registration.def("compute_fpfh_feature", &ComputeFPFHFeature,
-                       "Function to compute FPFH feature for a point cloud",
-                       "input"_a, "search_param"_a);
+
+    // tiny3d.registration.FeatureMatchingOption
+    auto feature_matching_option =
+            static_cast<py::class_<FeatureMatchingOption>>(
+                    m_registration.attr("FeatureMatchingOption"));
+    py::detail::bind_copy_functions<FeatureMatchingOption>(
+            feature_matching_option);
+    feature_matching_option
+            .def(py::init([](FeatureMatchingMethod method, int num_trees,
+                             int max_checks) {
+                     return new FeatureMatchingOption(method, num_trees,
+                                                      max_checks);
+                 }),
+                 "method"_a = FeatureMatchingMethod::KDTree,
+                 "num_trees"_a = 4, "max_checks"_a = 128)
+            .def_readwrite("method", &FeatureMatchingOption::method_,
+                           "Nearest neighbor search method.")
+            .def_readwrite("num_trees", &FeatureMatchingOption::num_trees_,
+                           "Number of randomized trees of the ``KDTreeForest`` "
+                           "method.")
+            .def_readwrite("max_checks", &FeatureMatchingOption::max_checks_,
+                           "Maximum number of distance evaluations per query "
+                           "of the ``KDTreeForest`` method. Larger values "
+                           "increase the recall at the cost of speed.")
+            .def("__repr__", [](const FeatureMatchingOption &c) {
+                return fmt::format(
+                        "FeatureMatchingOption("
+                        "method={}, "
+                        "num_trees={:d}, "
+                        "max_checks={:d})",
+                        c.method_ == FeatureMatchingMethod::KDTree
+                                ? "KDTree"
+                        : c.method_ == FeatureMatchingMethod::KDTreeForest
+                                ? "KDTreeForest"
+                                : "BruteForce",
+                        c.num_trees_, c.max_checks_);
+            });
+
+    m_registration.def(
+            "compute_fpfh_feature",
+            py::overload_cast<const geometry::PointCloud &,
+                              const geometry::KDTreeSearchParam &>(
+                    &ComputeFPFHFeature),
+            "Function to compute FPFH feature for a point cloud", "input"_a,
+            "search_param"_a);
+    m_registration.def(
+            "compute_fpfh_feature",
+            py::overload_cast<const geometry::PointCloud &,
+                              const geometry::KDTreeSearchParam &,
+                              const std::vector<size_t> &>(&ComputeFPFHFeature),
+            "Function to compute FPFH feature for a subset of the points of a "
+            "point cloud, using neighborhoods from the whole point cloud",
+            "input"_a, "search_param"_a, "indices"_a);
     docstring::FunctionDocInject(
             m_registration, "compute_fpfh_feature",
             {
                     {"input", "The Input point cloud."},
                     {"search_param", "KDTree KNN search parameter."},
+                    {"indices",
+                     "Indices of the points to compute FPFH features on, e.g. "
+                     "keypoints. Column i of the result is the feature of "
+                     "point indices[i]."},
             });
 
     m_registration.def(
             "correspondences_from_features", &CorrespondencesFromFeatures,
             "Function to find nearest neighbor correspondences from features",
             "source_features"_a, "target_features"_a, "mutual_filter"_a = false,
-            "mutual_consistency_ratio"_a = 0.1f);
+            "mutual_consistency_ratio"_a = 0.1f,
+            "option"_a = FeatureMatchingOption());
     docstring::FunctionDocInject(
             m_registration, "correspondences_from_features",
             {{"source_features", "The source features stored in (dim, N)."},
@@ -79,7 +157,43 @@ void pybind_feature_definitions(py::module &m_registration) {
              {"mutual_consistency_ratio",
               "Threshold to decide whether the number of filtered "
               "correspondences is sufficient. Only used when mutual_filter is "
-              "enabled."}});
+              "enabled."},
+             {"option",
+              "Nearest neighbor search options, selects between exact and "
+              "approximate matching."}});
+
+    m_registration.def(
+            "correspondences_from_features_knn",
+            &CorrespondencesFromFeaturesKNN,
+            "Function to find the k nearest neighbor candidate "
+            "correspondences of every source feature, optionally filtered by "
+            "Lowe's ratio test. Returns the correspondences and their feature "
+            "distances",
+            "source_features"_a, "target_features"_a, "knn"_a = 1,
+            "ratio_threshold"_a = 1.0, "option"_a = FeatureMatchingOption());
+    docstring::FunctionDocInject(
+            m_registration, "correspondences_from_features_knn",
+            {{"source_features", "The source features stored in (dim, N)."},
+             {"target_features", "The target features stored in (dim, M)."},
+             {"knn", "Number of candidates per source feature."},
+             {"ratio_threshold",
+              "Keeps a candidate only if its feature distance is below "
+              "ratio_threshold times the distance of the (knn + 1)-th nearest "
+              "neighbor. Values of 1 or larger disable the test."},
+             {"option", "Nearest neighbor search options."}});
+
+    m_registration.def("compute_correspondence_feature_distances",
+                       &ComputeCorrespondenceFeatureDistances,
+                       "Function to compute the feature space distance of "
+                       "correspondences, which can be used as their quality "
+                       "score",
+                       "source_features"_a, "target_features"_a, "corres"_a);
+    docstring::FunctionDocInject(
+            m_registration, "compute_correspondence_feature_distances",
+            {{"source_features", "The source features stored in (dim, N)."},
+             {"target_features", "The target features stored in (dim, M)."},
+             {"corres",
+              "Correspondence set between source and target features."}});
 }
 
 }  // namespace registration
@@ -12,7 +12,9 @@
 
 #include "tiny3d/geometry/PointCloud.h"
 #include "tiny3d/pipelines/registration/CorrespondenceChecker.h"
+#include "tiny3d/pipelines/registration/FastGlobalRegistration.h"
 #include "tiny3d/pipelines/registration/Feature.h"
+#include "tiny3d/pipelines/registration/MaxCliqueRegistration.h"
 #include "tiny3d/pipelines/registration/TransformationEstimation.h"
 #include "tiny3d/utility/Logging.h"
 #include "pybind/docstring.h"
@@ -83,6 +85,33 @@ void pybind_registration_declarations(py::module &m) {
             "where ``ransac_n`` is the number of points used "
             "during a ransac iteration. Use confidence=1.0 "
             "to avoid early termination.");
+    py::enum_<RANSACScoring> ransac_scoring(m_registration, "RANSACScoring",
+                                            py::arithmetic());
+    ransac_scoring.value("PointCloud", RANSACScoring::PointCloud)
+            .value("Correspondence", RANSACScoring::Correspondence)
+            .export_values();
+    ransac_scoring.attr("__doc__") = docstring::static_property(
+            py::cpp_function([](py::handle arg) -> std::string {
+                return "Enum class that selects how RANSAC scores hypotheses. "
+                       "``PointCloud`` validates every hypothesis with nearest "
+                       "neighbor searches on the point clouds, "
+                       "``Correspondence`` counts inlier correspondences and "
+                       "only validates the final best hypotheses.";
+            }),
+            py::none(), py::none(), "");
+    py::enum_<RANSACSampling> ransac_sampling(m_registration, "RANSACSampling",
+                                              py::arithmetic());
+    ransac_sampling.value("Uniform", RANSACSampling::Uniform)
+            .value("Progressive", RANSACSampling::Progressive)
+            .export_values();
+    ransac_sampling.attr("__doc__") = docstring::static_property(
+            py::cpp_function([](py::handle arg) -> std::string {
+                return "Enum class that selects how RANSAC samples "
+                       "correspondences. ``Uniform`` draws them uniformly at "
+                       "random, ``Progressive`` uses PROSAC sampling on "
+                       "correspondences sorted by decreasing quality.";
+            }),
+            py::none(), py::none(), "");
     py::class_<TransformationEstimation,
                PyTransformationEstimation<TransformationEstimation>>
             te(m_registration, "TransformationEstimation",
@@ -134,6 +163,13 @@ void pybind_registration_declarations(py::module &m) {
                  "normals. It considers vertex normal affinity of any "
                  "correspondences. It computes dot product of two normal "
                  "vectors. It takes radian value for the threshold.");
+    py::class_<FastGlobalRegistrationOption> fgr_option(
+            m_registration, "FastGlobalRegistrationOption",
+            "Options for FastGlobalRegistration.");
+    py::class_<MaxCliqueRegistrationOption> max_clique_option(
+            m_registration, "MaxCliqueRegistrationOption",
+            "Options for global registration based on the maximum clique of "
+            "pairwise consistent correspondences.");
     py::class_<RegistrationResult> registration_result(
             m_registration, "RegistrationResult",
             "Class that contains the registration results.");
@@ -199,6 +235,149 @@ void pybind_registration_definitions(py::module &m) {
                         c.max_iteration_, c.confidence_);
             });
 
+    // tiny3d.registration.FastGlobalRegistrationOption
+    auto fgr_option = static_cast<py::class_<FastGlobalRegistrationOption>>(
+            m_registration.attr("FastGlobalRegistrationOption"));
+    py::detail::bind_copy_functions<FastGlobalRegistrationOption>(fgr_option);
+    fgr_option
+            .def(py::init([](double division_factor, bool use_absolute_scale,
+                             bool decrease_mu,
+                             double maximum_correspondence_distance,
+                             int iteration_number, double tuple_scale,
+                             int maximum_tuple_count, bool tuple_test) {
+                     return new FastGlobalRegistrationOption(
+                             division_factor, use_absolute_scale, decrease_mu,
+                             maximum_correspondence_distance, iteration_number,
+                             tuple_scale, maximum_tuple_count, tuple_test);
+                 }),
+                 "division_factor"_a = 1.4, "use_absolute_scale"_a = false,
+                 "decrease_mu"_a = true,
+                 "maximum_correspondence_distance"_a = 0.025,
+                 "iteration_number"_a = 64, "tuple_scale"_a = 0.95,
+                 "maximum_tuple_count"_a = 1000, "tuple_test"_a = true)
+            .def_readwrite("division_factor",
+                           &FastGlobalRegistrationOption::division_factor_,
+                           "Division factor used for graduated non-convexity.")
+            .def_readwrite("use_absolute_scale",
+                           &FastGlobalRegistrationOption::use_absolute_scale_,
+                           "Measure distance in absolute scale (True) or in "
+                           "scale relative to the diameter of the model "
+                           "(False).")
+            .def_readwrite("decrease_mu",
+                           &FastGlobalRegistrationOption::decrease_mu_,
+                           "Set to ``True`` to decrease scale mu by "
+                           "``division_factor`` for graduated non-convexity.")
+            .def_readwrite("maximum_correspondence_distance",
+                           &FastGlobalRegistrationOption::
+                                   maximum_correspondence_distance_,
+                           "Maximum correspondence distance, measured as "
+                           "selected by ``use_absolute_scale``.")
+            .def_readwrite("iteration_number",
+                           &FastGlobalRegistrationOption::iteration_number_,
+                           "Maximum number of iterations.")
+            .def_readwrite("tuple_scale",
+                           &FastGlobalRegistrationOption::tuple_scale_,
+                           "Similarity measure used for tuples of feature "
+                           "points.")
+            .def_readwrite("maximum_tuple_count",
+                           &FastGlobalRegistrationOption::maximum_tuple_count_,
+                           "Maximum number of tuples.")
+            .def_readwrite("tuple_test",
+                           &FastGlobalRegistrationOption::tuple_test_,
+                           "Set to ``True`` to perform geometric compatibility "
+                           "tests on the initial set of correspondences.")
+            .def("__repr__", [](const FastGlobalRegistrationOption &c) {
+                return fmt::format(
+                        "FastGlobalRegistrationOption("
+                        "division_factor={:e}, "
+                        "use_absolute_scale={}, "
+                        "decrease_mu={}, "
+                        "maximum_correspondence_distance={:e}, "
+                        "iteration_number={:d}, "
+                        "tuple_scale={:e}, "
+                        "maximum_tuple_count={:d}, "
+                        "tuple_test={})",
+                        c.division_factor_, c.use_absolute_scale_,
+                        c.decrease_mu_, c.maximum_correspondence_distance_,
+                        c.iteration_number_, c.tuple_scale_,
+                        c.maximum_tuple_count_, c.tuple_test_);
+            });
+
+    // tiny3d.registration.MaxCliqueRegistrationOption
+    auto max_clique_option =
+            static_cast<py::class_<MaxCliqueRegistrationOption>>(
+                    m_registration.attr("MaxCliqueRegistrationOption"));
+    py::detail::bind_copy_functions<MaxCliqueRegistrationOption>(
+            max_clique_option);
+    max_clique_option
+            .def(py::init([](bool with_scaling, bool exact_max_clique,
+                             double max_clique_time_limit,
+                             double rotation_gnc_factor,
+                             int rotation_max_iteration,
+                             double rotation_cost_threshold,
+                             int max_num_correspondences) {
+                     return new MaxCliqueRegistrationOption(
+                             with_scaling, exact_max_clique,
+                             max_clique_time_limit, rotation_gnc_factor,
+                             rotation_max_iteration, rotation_cost_threshold,
+                             max_num_correspondences);
+                 }),
+                 "with_scaling"_a = false, "exact_max_clique"_a = true,
+                 "max_clique_time_limit"_a = 10.0,
+                 "rotation_gnc_factor"_a = 1.4,
+                 "rotation_max_iteration"_a = 100,
+                 "rotation_cost_threshold"_a = 1e-6,
+                 "max_num_correspondences"_a = 5000)
+            .def_readwrite("with_scaling",
+                           &MaxCliqueRegistrationOption::with_scaling_,
+                           "Estimate a uniform scale between source and "
+                           "target.")
+            .def_readwrite("exact_max_clique",
+                           &MaxCliqueRegistrationOption::exact_max_clique_,
+                           "Solve the maximum clique exactly. If False, a "
+                           "greedy heuristic is used.")
+            .def_readwrite(
+                    "max_clique_time_limit",
+                    &MaxCliqueRegistrationOption::max_clique_time_limit_,
+                    "Time limit in seconds for the exact maximum clique "
+                    "search.")
+            .def_readwrite("rotation_gnc_factor",
+                           &MaxCliqueRegistrationOption::rotation_gnc_factor_,
+                           "Factor the GNC control parameter grows by in "
+                           "every rotation estimation iteration.")
+            .def_readwrite(
+                    "rotation_max_iteration",
+                    &MaxCliqueRegistrationOption::rotation_max_iteration_,
+                    "Maximum number of GNC iterations of the rotation "
+                    "estimation.")
+            .def_readwrite(
+                    "rotation_cost_threshold",
+                    &MaxCliqueRegistrationOption::rotation_cost_threshold_,
+                    "Change of the rotation cost below which the GNC "
+                    "iterations stop.")
+            .def_readwrite(
+                    "max_num_correspondences",
+                    &MaxCliqueRegistrationOption::max_num_correspondences_,
+                    "Maximum number of correspondences the consistency "
+                    "graph is built on. Feature matching keeps the ones of "
+                    "lowest feature distance, given correspondences are "
+                    "subsampled evenly. Zero or less keeps all.")
+            .def("__repr__", [](const MaxCliqueRegistrationOption &c) {
+                return fmt::format(
+                        "MaxCliqueRegistrationOption("
+                        "with_scaling={}, "
+                        "exact_max_clique={}, "
+                        "max_clique_time_limit={:e}, "
+                        "rotation_gnc_factor={:e}, "
+                        "rotation_max_iteration={:d}, "
+                        "rotation_cost_threshold={:e}, "
+                        "max_num_correspondences={:d})",
+                        c.with_scaling_, c.exact_max_clique_,
+                        c.max_clique_time_limit_, c.rotation_gnc_factor_,
+                        c.rotation_max_iteration_, c.rotation_cost_threshold_,
+                        c.max_num_correspondences_);
+            });
+
     // tiny3d.registration.TransformationEstimation
     auto te = static_cast<
             py::class_<TransformationEstimation,
@@ -457,6 +636,17 @@ must hold true for all edges.)");
                     {"option", "Registration option"},
                     {"ransac_n",
                      "Fit ransac with ``ransac_n`` correspondences"},
+                    {"scoring",
+                     "How RANSAC scores hypotheses. One of "
+                     "(``RANSACScoring.PointCloud``, "
+                     "``RANSACScoring.Correspondence``)"},
+                    {"sampling",
+                     "How RANSAC samples correspondences. One of "
+                     "(``RANSACSampling.Uniform``, "
+                     "``RANSACSampling.Progressive``). With "
+                     "``RANSACSampling.Progressive``, ``corres`` must be sorted "
+                     "by decreasing quality, while feature matching ranks "
+                     "correspondences by feature distance."},
                     {"source_feature", "Source point cloud feature."},
                     {"source", "The source point cloud."},
                     {"target_feature", "Target point cloud feature."},
@@ -496,7 +686,9 @@ must hold true for all edges.)");
             "ransac_n"_a = 3,
             "checkers"_a = std::vector<
                     std::reference_wrapper<const CorrespondenceChecker>>(),
-            "criteria"_a = RANSACConvergenceCriteria(100000, 0.999));
+            "criteria"_a = RANSACConvergenceCriteria(100000, 0.999),
+            "scoring"_a = RANSACScoring::PointCloud,
+            "sampling"_a = RANSACSampling::Uniform);
     docstring::FunctionDocInject(m_registration,
                                  "registration_ransac_based_on_correspondence",
                                  map_shared_argument_docstrings);
@@ -512,12 +704,62 @@ must hold true for all edges.)");
             "ransac_n"_a = 3,
             "checkers"_a = std::vector<
                     std::reference_wrapper<const CorrespondenceChecker>>(),
-            "criteria"_a = RANSACConvergenceCriteria(100000, 0.999));
+            "criteria"_a = RANSACConvergenceCriteria(100000, 0.999),
+            "scoring"_a = RANSACScoring::PointCloud,
+            "sampling"_a = RANSACSampling::Uniform);
     docstring::FunctionDocInject(
             m_registration, "registration_ransac_based_on_feature_matching",
             map_shared_argument_docstrings);
 
 
+    m_registration.def(
+            "registration_fgr_based_on_correspondence",
+            &RegistrationFGRBasedOnCorrespondence,
+            py::call_guard<py::gil_scoped_release>(),
+            "Function for fast global registration based on a set of "
+            "correspondences",
+            "source"_a, "target"_a, "corres"_a,
+            "option"_a = FastGlobalRegistrationOption());
+    docstring::FunctionDocInject(m_registration,
+                                 "registration_fgr_based_on_correspondence",
+                                 map_shared_argument_docstrings);
+
+    m_registration.def(
+            "registration_fgr_based_on_feature_matching",
+            &RegistrationFGRBasedOnFeatureMatching,
+            py::call_guard<py::gil_scoped_release>(),
+            "Function for fast global registration based on feature matching",
+            "source"_a, "target"_a, "source_feature"_a, "target_feature"_a,
+            "option"_a = FastGlobalRegistrationOption());
+    docstring::FunctionDocInject(m_registration,
+                                 "registration_fgr_based_on_feature_matching",
+                                 map_shared_argument_docstrings);
+
+    m_registration.def(
+            "registration_max_clique_based_on_correspondence",
+            &RegistrationMaxCliqueBasedOnCorrespondence,
+            py::call_guard<py::gil_scoped_release>(),
+            "Function for global registration based on the maximum clique of "
+            "a set of correspondences",
+            "source"_a, "target"_a, "corres"_a, "max_correspondence_distance"_a,
+            "option"_a = MaxCliqueRegistrationOption());
+    docstring::FunctionDocInject(
+            m_registration, "registration_max_clique_based_on_correspondence",
+            map_shared_argument_docstrings);
+
+    m_registration.def(
+            "registration_max_clique_based_on_feature_matching",
+            &RegistrationMaxCliqueBasedOnFeatureMatching,
+            py::call_guard<py::gil_scoped_release>(),
+            "Function for global registration based on the maximum clique of "
+            "feature matching correspondences",
+            "source"_a, "target"_a, "source_feature"_a, "target_feature"_a,
+            "mutual_filter"_a, "max_correspondence_distance"_a,
+            "option"_a = MaxCliqueRegistrationOption());
+    docstring::FunctionDocInject(
+            m_registration, "registration_max_clique_based_on_feature_matching",
+            map_shared_argument_docstrings);
+
     m_registration.def(
             "get_information_matrix_from_point_clouds",
             &GetInformationMatrixFromPointClouds,
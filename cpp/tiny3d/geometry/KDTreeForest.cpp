@@ -0,0 +1,277 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/geometry/KDTreeForest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include "tiny3d/utility/Logging.h"
+#include "tiny3d/utility/Parallel.h"
+#include "tiny3d/utility/Random.h"
+
+namespace tiny3d {
+namespace geometry {
+
+namespace {
+
+/// Maximum number of points in a leaf.
+constexpr int kMaxLeafSize = 16;
+/// Number of points sampled to estimate the variance of a node.
+constexpr int kNumVarianceSamples = 100;
+/// Number of highest variance dimensions the split is drawn from.
+constexpr int kNumSplitCandidates = 5;
+
+}  // namespace
+
+KDTreeForest::KDTreeForest(int num_trees) : num_trees_(num_trees) {
+    if (num_trees < 1) {
+        utility::LogError("num_trees must be positive, but got {:d}.",
+                          num_trees);
+    }
+}
+
+KDTreeForest::KDTreeForest(const Eigen::MatrixXd &data, int num_trees)
+    : KDTreeForest(num_trees) {
+    SetMatrixData(data);
+}
+
+KDTreeForest::KDTreeForest(const pipelines::registration::Feature &feature,
+                           int num_trees)
+    : KDTreeForest(num_trees) {
+    SetFeature(feature);
+}
+
+KDTreeForest::~KDTreeForest() {}
+
+bool KDTreeForest::SetMatrixData(const Eigen::MatrixXd &data) {
+    dimension_ = static_cast<int>(data.rows());
+    num_points_ = static_cast<int>(data.cols());
+    data_.resize(data.size());
+    Eigen::Map<Eigen::MatrixXf>(data_.data(), dimension_, num_points_) =
+            data.cast<float>();
+    nodes_.clear();
+    roots_.clear();
+    indices_.clear();
+    if (dimension_ == 0 || num_points_ == 0) {
+        return false;
+    }
+
+    // Trees are built in parallel, each from its own random stream.
+    const uint64_t seed = utility::random::RandUint32();
+    std::vector<std::vector<Node>> tree_nodes(num_trees_);
+    std::vector<std::vector<int>> tree_indices(num_trees_);
+#pragma omp parallel for schedule(dynamic, 1) \
+        num_threads(utility::EstimateMaxThreads())
+    for (int t = 0; t < num_trees_; t++) {
+        utility::random::LocalUniformIntGenerator<int> engine(0, 0, seed, t);
+        tree_indices[t].resize(num_points_);
+        std::iota(tree_indices[t].begin(), tree_indices[t].end(), 0);
+        BuildTree(0, num_points_, tree_indices[t], tree_nodes[t], engine);
+    }
+
+    for (int t = 0; t < num_trees_; t++) {
+        const int node_offset = static_cast<int>(nodes_.size());
+        const int index_offset = static_cast<int>(indices_.size());
+        roots_.push_back(node_offset);
+        for (Node node : tree_nodes[t]) {
+            if (node.dim >= 0) {
+                node.right_or_begin += node_offset;
+            } else {
+                node.right_or_begin += index_offset;
+                node.end += index_offset;
+            }
+            nodes_.push_back(node);
+        }
+        indices_.insert(indices_.end(), tree_indices[t].begin(),
+                        tree_indices[t].end());
+    }
+    return true;
+}
+
+bool KDTreeForest::SetFeature(const pipelines::registration::Feature &feature) {
+    return SetMatrixData(feature.data_);
+}
+
+template <typename RandomEngine>
+int KDTreeForest::BuildTree(int begin,
+                            int end,
+                            std::vector<int> &indices,
+                            std::vector<Node> &nodes,
+                            RandomEngine &engine) const {
+    const int node_index = static_cast<int>(nodes.size());
+    nodes.push_back(Node{-1, 0.0f, begin, end});
+    const int count = end - begin;
+    if (count <= kMaxLeafSize) {
+        return node_index;
+    }
+    auto value = [&](int i, int d) {
+        return data_[static_cast<size_t>(i) * dimension_ + d];
+    };
+
+    // Mean and variance of every dimension, estimated on a subsample.
+    const int num_samples = std::min(count, kNumVarianceSamples);
+    Eigen::VectorXd sum = Eigen::VectorXd::Zero(dimension_);
+    Eigen::VectorXd sum2 = Eigen::VectorXd::Zero(dimension_);
+    for (int s = 0; s < num_samples; s++) {
+        const int i = indices[begin + static_cast<int64_t>(s) * count /
+                                              num_samples];
+        for (int d = 0; d < dimension_; d++) {
+            sum(d) += value(i, d);
+            sum2(d) += double(value(i, d)) * value(i, d);
+        }
+    }
+    const Eigen::VectorXd mean = sum / num_samples;
+    const Eigen::VectorXd variance =
+            sum2 / num_samples - mean.cwiseProduct(mean);
+
+    // Split on a random dimension among the ones of highest variance.
+    std::vector<int> dims(dimension_);
+    std::iota(dims.begin(), dims.end(), 0);
+    const int num_candidates = std::min(kNumSplitCandidates, dimension_);
+    std::partial_sort(dims.begin(), dims.begin() + num_candidates, dims.end(),
+                      [&](int a, int b) { return variance(a) > variance(b); });
+    int num_varying = 0;
+    while (num_varying < num_candidates && variance(dims[num_varying]) > 0.0) {
+        num_varying++;
+    }
+    if (num_varying == 0) {
+        if (num_samples == count) {
+            // All points are identical.
+            return node_index;
+        }
+        num_varying = 1;
+    }
+    const int dim = dims[engine(0, num_varying - 1)];
+    float split = static_cast<float>(mean(dim));
+    auto first = indices.begin() + begin;
+    auto last = indices.begin() + end;
+    auto middle = std::partition(
+            first, last, [&](int i) { return value(i, dim) < split; });
+    if (middle == first || middle == last) {
+        // The mean does not separate the points, split at the median.
+        middle = first + count / 2;
+        std::nth_element(first, middle, last, [&](int a, int b) {
+            return value(a, dim) < value(b, dim);
+        });
+        split = value(*middle, dim);
+    }
+    const int mid = static_cast<int>(middle - indices.begin());
+
+    BuildTree(begin, mid, indices, nodes, engine);
+    const int right = BuildTree(mid, end, indices, nodes, engine);
+    nodes[node_index].dim = dim;
+    nodes[node_index].split = split;
+    nodes[node_index].right_or_begin = right;
+    return node_index;
+}
+
+int KDTreeForest::SearchKNN(const double *query_data,
+                            int query_size,
+                            int knn,
+                            int max_checks,
+                            std::vector<int> &indices,
+                            std::vector<double> &distance2) const {
+    if (num_points_ == 0 || query_size != dimension_ || knn < 0) {
+        return -1;
+    }
+    knn = std::min(knn, num_points_);
+    const Eigen::VectorXf query =
+            Eigen::Map<const Eigen::VectorXd>(query_data, dimension_)
+                    .cast<float>();
+
+    // Neighbors found so far, sorted by increasing distance.
+    std::vector<std::pair<float, int>> neighbors;
+    neighbors.reserve(knn + 1);
+    auto worst_distance2 = [&]() {
+        return static_cast<int>(neighbors.size()) < knn
+                       ? std::numeric_limits<float>::infinity()
+                       : neighbors.back().first;
+    };
+    // Unexplored branches of all trees, ordered by their distance bound.
+    using Branch = std::pair<float, int>;
+    std::vector<Branch> branches;
+    int checks = 0;
+
+    auto descend = [&](int node_index, float min_distance2) {
+        while (nodes_[node_index].dim >= 0) {
+            const Node &node = nodes_[node_index];
+            const float diff = query(node.dim) - node.split;
+            const int near_child =
+                    diff < 0.0f ? node_index + 1 : node.right_or_begin;
+            const int far_child =
+                    diff < 0.0f ? node.right_or_begin : node_index + 1;
+            const float far_distance2 = min_distance2 + diff * diff;
+            if (far_distance2 < worst_distance2()) {
+                branches.emplace_back(far_distance2, far_child);
+                std::push_heap(branches.begin(), branches.end(),
+                               std::greater<Branch>());
+            }
+            node_index = near_child;
+        }
+        const Node &leaf = nodes_[node_index];
+        for (int k = leaf.right_or_begin; k < leaf.end; k++) {
+            const int i = indices_[k];
+            const float d2 = (Eigen::Map<const Eigen::VectorXf>(
+                                      &data_[static_cast<size_t>(i) *
+                                             dimension_],
+                                      dimension_) -
+                              query)
+                                     .squaredNorm();
+            checks++;
+            if (!(d2 < worst_distance2())) {
+                continue;
+            }
+            // The trees share the points, skip the ones already found.
+            if (std::any_of(neighbors.begin(), neighbors.end(),
+                            [i](const std::pair<float, int> &n) {
+                                return n.second == i;
+                            })) {
+                continue;
+            }
+            neighbors.insert(std::upper_bound(neighbors.begin(),
+                                              neighbors.end(),
+                                              std::make_pair(d2, i)),
+                             std::make_pair(d2, i));
+            if (static_cast<int>(neighbors.size()) > knn) {
+                neighbors.pop_back();
+            }
+        }
+    };
+
+    if (knn > 0) {
+        for (const int root : roots_) {
+            descend(root, 0.0f);
+        }
+        while (!branches.empty() && checks < max_checks) {
+            std::pop_heap(branches.begin(), branches.end(),
+                          std::greater<Branch>());
+            const Branch branch = branches.back();
+            branches.pop_back();
+            if (!(branch.first < worst_distance2())) {
+                break;
+            }
+            descend(branch.second, branch.first);
+        }
+    }
+
+    const int k = static_cast<int>(neighbors.size());
+    indices.resize(k);
+    distance2.resize(k);
+    for (int j = 0; j < k; j++) {
+        distance2[j] = neighbors[j].first;
+        indices[j] = neighbors[j].second;
+    }
+    return k;
+}
+
+}  // namespace geometry
+}  // namespace tiny3d
@@ -0,0 +1,115 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <vector>
+
+#include "tiny3d/pipelines/registration/Feature.h"
+
+namespace tiny3d {
+namespace geometry {
+
+/// \class KDTreeForest
+///
+/// \brief Randomized KD-tree forest for approximate nearest neighbor search in
+/// high dimensional spaces, such as feature spaces.
+///
+/// Follows the randomized KD-trees of FLANN (Muja and Lowe, "Scalable Nearest
+/// Neighbor Algorithms for High Dimensional Data", TPAMI 2014): every tree
+/// splits on a dimension drawn at random among the ones of highest variance,
+/// and a query explores the branches of all trees in a single priority queue
+/// until a budget of distance evaluations is spent. Unlike KDTreeFlann, the
+/// cost of a query is bounded by the budget instead of growing towards brute
+/// force with the dimension. The data is stored in single precision.
+class KDTreeForest {
+public:
+    /// \brief Default Constructor.
+    ///
+    /// \param num_trees Number of randomized trees.
+    KDTreeForest(int num_trees = 4);
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param data Provides set of data points for the forest construction.
+    /// \param num_trees Number of randomized trees.
+    KDTreeForest(const Eigen::MatrixXd &data, int num_trees = 4);
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param feature Provides a set of features from which the forest is
+    /// constructed.
+    /// \param num_trees Number of randomized trees.
+    KDTreeForest(const pipelines::registration::Feature &feature,
+                 int num_trees = 4);
+    ~KDTreeForest();
+    KDTreeForest(const KDTreeForest &) = delete;
+    KDTreeForest &operator=(const KDTreeForest &) = delete;
+
+public:
+    /// Sets the data for the forest from a matrix.
+    ///
+    /// \param data Data points for the forest construction.
+    bool SetMatrixData(const Eigen::MatrixXd &data);
+    /// Sets the data for the forest from the feature data.
+    ///
+    /// \param feature Set of features for the forest construction.
+    bool SetFeature(const pipelines::registration::Feature &feature);
+
+    /// \brief Approximate K nearest neighbor search.
+    ///
+    /// \param query_data Pointer to the query point.
+    /// \param query_size Dimension of the query point.
+    /// \param knn Number of neighbors to search.
+    /// \param max_checks Maximum number of distance evaluations. Larger values
+    /// increase the recall at the cost of speed.
+    /// \param indices Indices of the neighbors, sorted by increasing distance.
+    /// \param distance2 Squared distances of the neighbors.
+    /// \return The number of neighbors found, or -1 on invalid input.
+    int SearchKNN(const double *query_data,
+                  int query_size,
+                  int knn,
+                  int max_checks,
+                  std::vector<int> &indices,
+                  std::vector<double> &distance2) const;
+
+private:
+    struct Node {
+        /// Split dimension, or -1 for leaves.
+        int dim;
+        /// Split value of inner nodes.
+        float split;
+        /// Right child of inner nodes (the left child directly follows its
+        /// parent), or the first entry of leaves in indices_.
+        int right_or_begin;
+        /// End of the entries of leaves in indices_.
+        int end;
+    };
+
+    /// Recursively builds the subtree on \p indices in [begin, end) and
+    /// returns the index of its root node.
+    template <typename RandomEngine>
+    int BuildTree(int begin,
+                  int end,
+                  std::vector<int> &indices,
+                  std::vector<Node> &nodes,
+                  RandomEngine &engine) const;
+
+protected:
+    int num_trees_;
+    int dimension_ = 0;
+    int num_points_ = 0;
+    /// Column-major data, dimension_ x num_points_.
+    std::vector<float> data_;
+    /// Nodes of all trees, each tree starting at its root in roots_.
+    std::vector<Node> nodes_;
+    std::vector<int> roots_;
+    /// Point indices of all trees, ordered by leaf.
+    std::vector<int> indices_;
+};
+
+}  // namespace geometry
+}  // namespace tiny3d
@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/geometry/Keypoint.h"
+
+#include <Eigen/Eigenvalues>
+#include <cmath>
+
+#include "tiny3d/geometry/KDTreeFlann.h"
+#include "tiny3d/geometry/PointCloud.h"
+#include "tiny3d/utility/Eigen.h"
+#include "tiny3d/utility/Logging.h"
+#include "tiny3d/utility/Parallel.h"
+
+namespace tiny3d {
+namespace geometry {
+namespace keypoint {
+
+namespace {
+
+/// Mean distance of the points to their nearest neighbor.
+double ComputeModelResolution(const PointCloud &input,
+                              const KDTreeFlann &kdtree) {
+    const int n_points = static_cast<int>(input.points_.size());
+    double resolution = 0.0;
+#pragma omp parallel num_threads(utility::EstimateMaxThreads())
+    {
+        std::vector<int> indices(2);
+        std::vector<double> distance2(2);
+#pragma omp for schedule(static) reduction(+ : resolution)
+        for (int i = 0; i < n_points; i++) {
+            if (kdtree.SearchKNN(input.points_[i], 2, indices, distance2) ==
+                2) {
+                resolution += std::sqrt(distance2[1]);
+            }
+        }
+    }
+    return resolution / n_points;
+}
+
+}  // namespace
+
+std::vector<size_t> ComputeISSKeypoints(const PointCloud &input,
+                                        double salient_radius /* = 0.0 */,
+                                        double non_max_radius /* = 0.0 */,
+                                        double gamma_21 /* = 0.975 */,
+                                        double gamma_32 /* = 0.975 */,
+                                        int min_neighbors /* = 5 */) {
+    if (!input.HasPoints()) {
+        utility::LogWarning("ComputeISSKeypoints: input point cloud is empty.");
+        return {};
+    }
+
+    KDTreeFlann kdtree(input);
+    if (salient_radius == 0.0 || non_max_radius == 0.0) {
+        const double resolution = ComputeModelResolution(input, kdtree);
+        salient_radius = salient_radius == 0.0 ? 6.0 * resolution
+                                               : salient_radius;
+        non_max_radius = non_max_radius == 0.0 ? 4.0 * resolution
+                                               : non_max_radius;
+        utility::LogDebug(
+                "ComputeISSKeypoints: resolution {:f}, salient_radius {:f}, "
+                "non_max_radius {:f}.",
+                resolution, salient_radius, non_max_radius);
+    }
+
+    // Smallest eigenvalue of the covariance of every point, 0 for points
+    // that are not salient.
+    const int n_points = static_cast<int>(input.points_.size());
+    std::vector<double> third_eigen(n_points, 0.0);
+#pragma omp parallel num_threads(utility::EstimateMaxThreads())
+    {
+        std::vector<int> indices;
+        std::vector<double> distance2;
+#pragma omp for schedule(dynamic, 1024)
+        for (int i = 0; i < n_points; i++) {
+            if (kdtree.SearchRadius(input.points_[i], salient_radius, indices,
+                                    distance2) < min_neighbors) {
+                continue;
+            }
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+            solver.computeDirect(
+                    utility::ComputeCovariance(input.points_, indices),
+                    Eigen::EigenvaluesOnly);
+            // Eigenvalues are sorted in increasing order.
+            const double e1 = solver.eigenvalues()(2);
+            const double e2 = solver.eigenvalues()(1);
+            const double e3 = solver.eigenvalues()(0);
+            if (e2 < gamma_21 * e1 && e3 < gamma_32 * e2) {
+                third_eigen[i] = e3;
+            }
+        }
+    }
+
+    // Non maximum suppression of the salient points.
+    std::vector<char> is_keypoint(n_points, 0);
+#pragma omp parallel num_threads(utility::EstimateMaxThreads())
+    {
+        std::vector<int> indices;
+        std::vector<double> distance2;
+#pragma omp for schedule(dynamic, 1024)
+        for (int i = 0; i < n_points; i++) {
+            if (third_eigen[i] <= 0.0) {
+                continue;
+            }
+            kdtree.SearchRadius(input.points_[i], non_max_radius, indices,
+                                distance2);
+            bool is_maximum = true;
+            for (const int j : indices) {
+                if (third_eigen[j] > third_eigen[i]) {
+                    is_maximum = false;
+                    break;
+                }
+            }
+            is_keypoint[i] = is_maximum ? 1 : 0;
+        }
+    }
+
+    std::vector<size_t> keypoints;
+    for (int i = 0; i < n_points; i++) {
+        if (is_keypoint[i]) {
+            keypoints.push_back(i);
+        }
+    }
+    utility::LogDebug(
+            "ComputeISSKeypoints: extracted {:d} keypoints from {:d} points.",
+            static_cast<int>(keypoints.size()), n_points);
+    return keypoints;
+}
+
+}  // namespace keypoint
+}  // namespace geometry
+}  // namespace tiny3d
@@ -0,0 +1,52 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace tiny3d {
+namespace geometry {
+
+class PointCloud;
+
+namespace keypoint {
+
+/// \brief Function that computes the ISS keypoints of a point cloud.
+///
+/// Implements the Intrinsic Shape Signatures detector (Zhong, "Intrinsic Shape
+/// Signatures: A Shape Descriptor for 3D Object Recognition", ICCV Workshops
+/// 2009). A point is salient if the eigenvalues l1 >= l2 >= l3 of the
+/// covariance of its neighborhood satisfy l2 / l1 < gamma_21 and
+/// l3 / l2 < gamma_32, and it is a keypoint if its smallest eigenvalue l3 is
+/// maximal within non_max_radius. Fewer and more distinctive points than a
+/// voxel downsampling make feature computation, matching and RANSAC cheaper.
+///
+/// \param input The input point cloud.
+/// \param salient_radius The radius of the spherical neighborhood used to
+/// compute the covariance of every point. If 0, 6 times the resolution of the
+/// point cloud (the mean distance of the points to their nearest neighbor).
+/// \param non_max_radius The radius of the non maximum suppression. If 0, 4
+/// times the resolution of the point cloud.
+/// \param gamma_21 The upper bound on the ratio between the second and the
+/// first eigenvalue.
+/// \param gamma_32 The upper bound on the ratio between the third and the
+/// second eigenvalue.
+/// \param min_neighbors Minimum number of neighbors within salient_radius for
+/// a point to be a keypoint.
+/// \return The sorted indices of the keypoints in \p input.
+std::vector<size_t> ComputeISSKeypoints(const PointCloud &input,
+                                        double salient_radius = 0.0,
+                                        double non_max_radius = 0.0,
+                                        double gamma_21 = 0.975,
+                                        double gamma_32 = 0.975,
+                                        int min_neighbors = 5);
+
+}  // namespace keypoint
+}  // namespace geometry
+}  // namespace tiny3d
@@ -0,0 +1,121 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/io/FeatureIO.h"
+
+#include <unordered_map>
+
+#include "tiny3d/utility/FileSystem.h"
+#include "tiny3d/utility/Logging.h"
+
+namespace tiny3d {
+
+namespace {
+using namespace io;
+
+static const std::unordered_map<
+        std::string,
+        std::function<bool(const std::string &,
+                           pipelines::registration::Feature &)>>
+        file_extension_to_feature_read_function{
+                {"t3d", ReadFeatureFromT3D},
+        };
+
+static const std::unordered_map<
+        std::string,
+        std::function<bool(const std::string &,
+                           const pipelines::registration::Feature &,
+                           const bool,
+                           const bool,
+                           const bool)>>
+        file_extension_to_feature_write_function{
+                {"t3d", WriteFeatureToT3D},
+        };
+
+}  // unnamed namespace
+
+namespace io {
+
+std::shared_ptr<pipelines::registration::Feature> CreateFeatureFromFile(
+        const std::string &filename) {
+    auto feature = std::make_shared<pipelines::registration::Feature>();
+    ReadFeature(filename, *feature);
+    return feature;
+}
+
+bool ReadFeature(const std::string &filename,
+                 pipelines::registration::Feature &feature) {
+    std::string filename_ext =
+            utility::filesystem::GetFileExtensionInLowerCase(filename);
+    if (filename_ext.empty()) {
+        utility::LogWarning(
+                "Read pipelines::registration::Feature failed: unknown file "
+                "extension.");
+        return false;
+    }
+    auto map_itr = file_extension_to_feature_read_function.find(filename_ext);
+    if (map_itr == file_extension_to_feature_read_function.end()) {
+        utility::LogWarning(
+                "Read pipelines::registration::Feature failed: unknown file "
+                "extension.");
+        return false;
+    }
+    bool success = map_itr->second(filename, feature);
+    utility::LogDebug(
+            "Read pipelines::registration::Feature: {:d} features of "
+            "dimension {:d}.",
+            feature.Num(), feature.Dimension());
+    return success;
+}
+
+bool WriteFeature(const std::string &filename,
+                  const pipelines::registration::Feature &feature,
+                  bool write_float32 /* = false*/,
+                  bool compressed /* = false*/,
+                  bool write_checksum /* = false*/) {
+    std::string filename_ext =
+            utility::filesystem::GetFileExtensionInLowerCase(filename);
+    if (filename_ext.empty()) {
+        utility::LogWarning(
+                "Write pipelines::registration::Feature failed: unknown file "
+                "extension.");
+        return false;
+    }
+    auto map_itr = file_extension_to_feature_write_function.find(filename_ext);
+    if (map_itr == file_extension_to_feature_write_function.end()) {
+        utility::LogWarning(
+                "Write pipelines::registration::Feature failed: unknown file "
+                "extension.");
+        return false;
+    }
+    bool success = map_itr->second(filename, feature, write_float32,
+                                   compressed, write_checksum);
+    utility::LogDebug(
+            "Write pipelines::registration::Feature: {:d} features of "
+            "dimension {:d}.",
+            feature.Num(), feature.Dimension());
+    return success;
+}
+
+bool ReadFeature(const unsigned char *buffer,
+                 const size_t length,
+                 pipelines::registration::Feature &feature) {
+    return ReadFeatureInMemoryFromT3D(buffer, length, feature);
+}
+
+bool WriteFeature(unsigned char *&buffer,
+                  size_t &length,
+                  const pipelines::registration::Feature &feature,
+                  bool write_float32 /* = false*/,
+                  bool compressed /* = false*/,
+                  bool write_checksum /* = false*/) {
+    return WriteFeatureInMemoryToT3D(buffer, length, feature, write_float32,
+                                     compressed, write_checksum);
+}
+
+}  // namespace io
+}  // namespace tiny3d
@@ -0,0 +1,81 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+
+#include "tiny3d/pipelines/registration/Feature.h"
+
+namespace tiny3d {
+namespace io {
+
+/// Factory function to create a feature from a file.
+/// Return an empty feature if fail to read the file.
+std::shared_ptr<pipelines::registration::Feature> CreateFeatureFromFile(
+        const std::string &filename);
+
+/// The general entrance for reading a Feature from a file
+/// The function calls read functions based on the extension name of filename.
+/// \return return true if the read function is successful, false otherwise.
+bool ReadFeature(const std::string &filename,
+                 pipelines::registration::Feature &feature);
+
+/// The general entrance for writing a Feature to a file
+/// The function calls write functions based on the extension name of filename.
+/// \param write_float32 Store the feature values in single precision, which
+/// halves the size of the file.
+/// \param compressed Compress the feature values, in parallel blocks. Sparse
+/// features such as FPFH histograms compress well.
+/// \param write_checksum Store a checksum of the data, verified when reading.
+/// \return return true if the write function is successful, false otherwise.
+bool WriteFeature(const std::string &filename,
+                  const pipelines::registration::Feature &feature,
+                  bool write_float32 = false,
+                  bool compressed = false,
+                  bool write_checksum = false);
+
+/// The general entrance for reading a Feature from memory, in the T3D format.
+/// \return return true if the read function is successful, false otherwise.
+bool ReadFeature(const unsigned char *buffer,
+                 const size_t length,
+                 pipelines::registration::Feature &feature);
+
+/// The general entrance for writing a Feature to memory, in the T3D format.
+/// The parameters are those of the file version of WriteFeature.
+/// \return return true if the write function is successful, false otherwise.
+bool WriteFeature(unsigned char *&buffer,
+                  size_t &length,
+                  const pipelines::registration::Feature &feature,
+                  bool write_float32 = false,
+                  bool compressed = false,
+                  bool write_checksum = false);
+
+/// The file is read through a memory mapping, only the feature values are
+/// copied.
+bool ReadFeatureFromT3D(const std::string &filename,
+                        pipelines::registration::Feature &feature);
+
+bool ReadFeatureInMemoryFromT3D(const unsigned char *buffer,
+                                const size_t length,
+                                pipelines::registration::Feature &feature);
+
+bool WriteFeatureToT3D(const std::string &filename,
+                       const pipelines::registration::Feature &feature,
+                       bool write_float32,
+                       bool compressed,
+                       bool write_checksum);
+
+bool WriteFeatureInMemoryToT3D(unsigned char *&buffer,
+                               size_t &length,
+                               const pipelines::registration::Feature &feature,
+                               bool write_float32,
+                               bool compressed,
+                               bool write_checksum);
+
+}  // namespace io
+}  // namespace tiny3d
@@ -15,8 +15,14 @@ namespace tiny3d {
 namespace io {
 
 static std::map<std::string, FileGeometry (*)(const std::string&)> gExt2Func = {
+        {"las", ReadFileGeometryTypeLAS},
+        {"pcd", ReadFileGeometryTypePCD},
         {"ply", ReadFileGeometryTypePLY},
         {"xyz", ReadFileGeometryTypeXYZ},
+        {"xyzn", ReadFileGeometryTypeXYZN},
+        {"xyzrgb", ReadFileGeometryTypeXYZRGB},
+        {"pts", ReadFileGeometryTypePTS},
+        {"t3d", ReadFileGeometryTypeT3D},
 };
 
 FileGeometry ReadFileGeometryType(const std::string& path) {
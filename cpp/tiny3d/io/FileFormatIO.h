@@ -24,8 +24,14 @@ enum FileGeometry {
 /// call ReadTriangleMesh(), ReadLineSet(), or ReadPointCloud()
 FileGeometry ReadFileGeometryType(const std::string& path);
 
+FileGeometry ReadFileGeometryTypeLAS(const std::string& path);
+FileGeometry ReadFileGeometryTypePCD(const std::string& path);
 FileGeometry ReadFileGeometryTypePLY(const std::string& path);
 FileGeometry ReadFileGeometryTypeXYZ(const std::string& path);
+FileGeometry ReadFileGeometryTypeXYZN(const std::string& path);
+FileGeometry ReadFileGeometryTypeXYZRGB(const std::string& path);
+FileGeometry ReadFileGeometryTypePTS(const std::string& path);
+FileGeometry ReadFileGeometryTypeT3D(const std::string& path);
 
 
 }  // namespace io
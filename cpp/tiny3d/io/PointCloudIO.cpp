@@ -25,6 +25,12 @@ static const std::unordered_map<
                            const ReadPointCloudOption &)>>
         file_extension_to_pointcloud_read_function{
                 {"xyz", ReadPointCloudFromXYZ},
+                {"xyzn", ReadPointCloudFromXYZN},
+                {"xyzrgb", ReadPointCloudFromXYZRGB},
+                {"pts", ReadPointCloudFromPTS},
+                {"pcd", ReadPointCloudFromPCD},
+                {"las", ReadPointCloudFromLAS},
+                {"t3d", ReadPointCloudFromT3D},
                 {"ply", ReadPointCloudFromPLY},
         };
 
@@ -36,6 +42,12 @@ static const std::unordered_map<
                            const ReadPointCloudOption &)>>
         in_memory_to_pointcloud_read_function{
                 {"mem::xyz", ReadPointCloudInMemoryFromXYZ},
+                {"mem::xyzn", ReadPointCloudInMemoryFromXYZN},
+                {"mem::xyzrgb", ReadPointCloudInMemoryFromXYZRGB},
+                {"mem::pts", ReadPointCloudInMemoryFromPTS},
+                {"mem::pcd", ReadPointCloudInMemoryFromPCD},
+                {"mem::las", ReadPointCloudInMemoryFromLAS},
+                {"mem::t3d", ReadPointCloudInMemoryFromT3D},
         };
 
 static const std::unordered_map<
@@ -45,6 +57,11 @@ static const std::unordered_map<
                            const WritePointCloudOption &)>>
         file_extension_to_pointcloud_write_function{
                 {"xyz", WritePointCloudToXYZ},
+                {"xyzn", WritePointCloudToXYZN},
+                {"xyzrgb", WritePointCloudToXYZRGB},
+                {"pts", WritePointCloudToPTS},
+                {"pcd", WritePointCloudToPCD},
+                {"t3d", WritePointCloudToT3D},
                 {"ply", WritePointCloudToPLY},
         };
 
@@ -56,6 +73,11 @@ static const std::unordered_map<
                            const WritePointCloudOption &)>>
         in_memory_to_pointcloud_write_function{
                 {"mem::xyz", WritePointCloudInMemoryToXYZ},
+                {"mem::xyzn", WritePointCloudInMemoryToXYZN},
+                {"mem::xyzrgb", WritePointCloudInMemoryToXYZRGB},
+                {"mem::pts", WritePointCloudInMemoryToPTS},
+                {"mem::pcd", WritePointCloudInMemoryToPCD},
+                {"mem::t3d", WritePointCloudInMemoryToT3D},
         };
 
 std::shared_ptr<geometry::PointCloud> CreatePointCloudFromFile(
@@ -133,10 +133,21 @@ struct WritePointCloudOption {
     /// Whether to save in Ascii or Binary.  Some savers are capable of doing
     /// either, other ignore this.
     IsAscii write_ascii;
-    /// Whether to save Compressed or Uncompressed.  Currently, only PCD is
-    /// capable of compressing, and only if using IsAscii::Binary, all other
-    /// formats ignore this.
+    /// Whether to save Compressed or Uncompressed.  Currently, only PCD and T3D
+    /// are capable of compressing, PCD only if using IsAscii::Binary, all
+    /// other formats ignore this.
     Compressed compressed;
+    /// Whether to store point coordinates and normals in single precision,
+    /// which halves their size. Currently, only PLY and T3D support this, all
+    /// other formats ignore this.
+    bool write_float32 = false;
+    /// Whether to store a checksum of the data, verified when reading.
+    /// Currently, only T3D supports this, all other formats ignore this.
+    bool write_checksum = false;
+    /// Number of digits after the decimal point of the coordinates written
+    /// by ASCII formats, or -1 for the shortest representation that reads
+    /// back exactly. Currently, only XYZ, XYZN, XYZRGB and PTS support this.
+    int precision = 10;
     /// Print progress to stdout about loading progress.  Also see
     /// \p update_progress if you want to have your own progress indicators or
     /// to be able to cancel loading.
@@ -185,6 +196,118 @@ bool WritePointCloudInMemoryToXYZ(unsigned char *&buffer,
                                   const geometry::PointCloud &pointcloud,
                                   const WritePointCloudOption &params);
 
+bool ReadPointCloudFromXYZN(const std::string &filename,
+                            geometry::PointCloud &pointcloud,
+                            const ReadPointCloudOption &params);
+
+bool ReadPointCloudInMemoryFromXYZN(const unsigned char *buffer,
+                                    const size_t length,
+                                    geometry::PointCloud &pointcloud,
+                                    const ReadPointCloudOption &params);
+
+bool WritePointCloudToXYZN(const std::string &filename,
+                           const geometry::PointCloud &pointcloud,
+                           const WritePointCloudOption &params);
+
+bool WritePointCloudInMemoryToXYZN(unsigned char *&buffer,
+                                   size_t &length,
+                                   const geometry::PointCloud &pointcloud,
+                                   const WritePointCloudOption &params);
+
+bool ReadPointCloudFromXYZRGB(const std::string &filename,
+                              geometry::PointCloud &pointcloud,
+                              const ReadPointCloudOption &params);
+
+bool ReadPointCloudInMemoryFromXYZRGB(const unsigned char *buffer,
+                                      const size_t length,
+                                      geometry::PointCloud &pointcloud,
+                                      const ReadPointCloudOption &params);
+
+bool WritePointCloudToXYZRGB(const std::string &filename,
+                             const geometry::PointCloud &pointcloud,
+                             const WritePointCloudOption &params);
+
+bool WritePointCloudInMemoryToXYZRGB(unsigned char *&buffer,
+                                     size_t &length,
+                                     const geometry::PointCloud &pointcloud,
+                                     const WritePointCloudOption &params);
+
+bool ReadPointCloudFromPTS(const std::string &filename,
+                           geometry::PointCloud &pointcloud,
+                           const ReadPointCloudOption &params);
+
+bool ReadPointCloudInMemoryFromPTS(const unsigned char *buffer,
+                                   const size_t length,
+                                   geometry::PointCloud &pointcloud,
+                                   const ReadPointCloudOption &params);
+
+bool WritePointCloudToPTS(const std::string &filename,
+                          const geometry::PointCloud &pointcloud,
+                          const WritePointCloudOption &params);
+
+bool WritePointCloudInMemoryToPTS(unsigned char *&buffer,
+                                  size_t &length,
+                                  const geometry::PointCloud &pointcloud,
+                                  const WritePointCloudOption &params);
+
+bool ReadPointCloudFromPCD(const std::string &filename,
+                           geometry::PointCloud &pointcloud,
+                           const ReadPointCloudOption &params);
+
+bool ReadPointCloudInMemoryFromPCD(const unsigned char *buffer,
+                                   const size_t length,
+                                   geometry::PointCloud &pointcloud,
+                                   const ReadPointCloudOption &params);
+
+bool WritePointCloudToPCD(const std::string &filename,
+                          const geometry::PointCloud &pointcloud,
+                          const WritePointCloudOption &params);
+
+bool WritePointCloudInMemoryToPCD(unsigned char *&buffer,
+                                  size_t &length,
+                                  const geometry::PointCloud &pointcloud,
+                                  const WritePointCloudOption &params);
+
+bool ReadPointCloudFromLAS(const std::string &filename,
+                           geometry::PointCloud &pointcloud,
+                           const ReadPointCloudOption &params);
+
+bool ReadPointCloudInMemoryFromLAS(const unsigned char *buffer,
+                                   const size_t length,
+                                   geometry::PointCloud &pointcloud,
+                                   const ReadPointCloudOption &params);
+
+/// Returns the number of point records of a LAS file, or -1 if it cannot be
+/// read.
+int64_t ReadLASPointCount(const std::string &filename);
+
+/// Reads the point records [first_point, first_point + num_points) of a LAS
+/// file, clamped to the records of the file. Only this part of the file is
+/// read, which allows processing files larger than memory piece by piece.
+bool ReadPointCloudRangeFromLAS(const std::string &filename,
+                                int64_t first_point,
+                                int64_t num_points,
+                                geometry::PointCloud &pointcloud,
+                                const ReadPointCloudOption &params = {});
+
+bool ReadPointCloudFromT3D(const std::string &filename,
+                           geometry::PointCloud &pointcloud,
+                           const ReadPointCloudOption &params);
+
+bool ReadPointCloudInMemoryFromT3D(const unsigned char *buffer,
+                                   const size_t length,
+                                   geometry::PointCloud &pointcloud,
+                                   const ReadPointCloudOption &params);
+
+bool WritePointCloudToT3D(const std::string &filename,
+                          const geometry::PointCloud &pointcloud,
+                          const WritePointCloudOption &params);
+
+bool WritePointCloudInMemoryToT3D(unsigned char *&buffer,
+                                  size_t &length,
+                                  const geometry::PointCloud &pointcloud,
+                                  const WritePointCloudOption &params);
+
 bool ReadPointCloudFromPLY(const std::string &filename,
                            geometry::PointCloud &pointcloud,
                            const ReadPointCloudOption &params);
@@ -0,0 +1,62 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/io/PointCloudReader.h"
+
+#include <functional>
+#include <unordered_map>
+
+#include "tiny3d/utility/FileSystem.h"
+#include "tiny3d/utility/Logging.h"
+
+namespace tiny3d {
+
+namespace {
+using namespace io;
+
+static const std::unordered_map<
+        std::string,
+        std::function<std::unique_ptr<PointCloudReader>(const std::string &)>>
+        file_extension_to_pointcloud_reader_function{
+                {"xyz", OpenPointCloudReaderForXYZ},
+                {"xyzn", OpenPointCloudReaderForXYZN},
+                {"xyzrgb", OpenPointCloudReaderForXYZRGB},
+                {"ply", OpenPointCloudReaderForPLY},
+        };
+
+}  // unnamed namespace
+
+namespace io {
+
+std::unique_ptr<PointCloudReader> PointCloudReader::Open(
+        const std::string &filename, const std::string &format) {
+    std::string reader_format = format;
+    if (reader_format == "auto") {
+        reader_format =
+                utility::filesystem::GetFileExtensionInLowerCase(filename);
+    }
+    auto map_itr =
+            file_extension_to_pointcloud_reader_function.find(reader_format);
+    if (map_itr == file_extension_to_pointcloud_reader_function.end()) {
+        utility::LogWarning(
+                "Open PointCloudReader failed: unknown file extension or "
+                "format without support for reading in chunks for {} "
+                "(format: {}).",
+                filename, format);
+        return nullptr;
+    }
+    try {
+        return map_itr->second(filename);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Open PointCloudReader failed with exception: {}",
+                            e.what());
+        return nullptr;
+    }
+}
+
+}  // namespace io
+}  // namespace tiny3d
@@ -0,0 +1,75 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "tiny3d/geometry/PointCloud.h"
+
+namespace tiny3d {
+namespace io {
+
+/// \class PointCloudReader
+///
+/// \brief Reads the points of a point cloud file in chunks, to process clouds
+/// that do not fit in memory, e.g. to compute their bounds or to downsample
+/// them.
+///
+/// The file is memory mapped and only the records of the requested chunks are
+/// decoded, so memory use is bounded by the chunk size: the pages of the
+/// mapping can be evicted by the operating system.
+class PointCloudReader {
+public:
+    virtual ~PointCloudReader() {}
+
+    /// Opens \p filename for reading in chunks. The format is inferred from
+    /// the file extension unless \p format is given.
+    /// \return The reader, or nullptr if the file cannot be opened or its
+    /// format does not support reading in chunks.
+    static std::unique_ptr<PointCloudReader> Open(
+            const std::string &filename, const std::string &format = "auto");
+
+public:
+    /// Returns the number of points of the file. Formats without a point
+    /// count in their header scan the whole file on the first call.
+    virtual int64_t GetPointCount() = 0;
+
+    /// Moves to the point at \p index, in [0, GetPointCount()]. Returns false
+    /// if \p index is out of range.
+    virtual bool Seek(int64_t index) = 0;
+
+    /// Replaces the content of \p chunk by the next points of the file, at
+    /// most \p max_points, and moves past them.
+    /// \return false, with an empty \p chunk, if no points remain or if the
+    /// file is corrupted.
+    virtual bool ReadChunk(int64_t max_points, geometry::PointCloud &chunk) = 0;
+
+    /// Returns the index of the next point to read.
+    int64_t GetPosition() const { return position_; }
+
+protected:
+    int64_t position_ = 0;
+};
+
+std::unique_ptr<PointCloudReader> OpenPointCloudReaderForXYZ(
+        const std::string &filename);
+
+std::unique_ptr<PointCloudReader> OpenPointCloudReaderForXYZN(
+        const std::string &filename);
+
+std::unique_ptr<PointCloudReader> OpenPointCloudReaderForXYZRGB(
+        const std::string &filename);
+
+/// Supports ASCII and binary little endian files.
+std::unique_ptr<PointCloudReader> OpenPointCloudReaderForPLY(
+        const std::string &filename);
+
+}  // namespace io
+}  // namespace tiny3d
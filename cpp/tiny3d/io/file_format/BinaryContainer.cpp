@@ -0,0 +1,400 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/io/file_format/BinaryContainer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "tiny3d/utility/Compression.h"
+#include "tiny3d/utility/Logging.h"
+#include "tiny3d/utility/Parallel.h"
+
+namespace tiny3d {
+namespace io {
+namespace binary_container {
+
+/// @cond
+namespace {
+
+constexpr char kMagic[8] = {'T', 'I', 'N', 'Y', '3', 'D', 'B', 'N'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kFlagChecksum = 1;
+constexpr uint32_t kCompressionLZF = 1;
+constexpr size_t kAlignment = 64;
+/// Size of the independently compressed blocks of compressed arrays, a
+/// multiple of the size of the scalar types.
+constexpr size_t kBlockSize = size_t(1) << 20;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_arrays;
+    uint32_t flags;
+    uint32_t reserved[3];
+};
+static_assert(sizeof(FileHeader) == 32, "unexpected padding");
+
+struct ArrayEntry {
+    char name[32];
+    uint32_t type;
+    /// 0 for raw values, kCompressionLZF for compressed blocks.
+    uint32_t compression;
+    int64_t rows;
+    int64_t cols;
+    /// Byte offset of the stored data from the beginning of the container.
+    uint64_t offset;
+    /// Size of the stored data in bytes.
+    uint64_t size;
+    uint64_t checksum;
+};
+static_assert(sizeof(ArrayEntry) == 80, "unexpected padding");
+
+bool IsLittleEndianHost() {
+    const uint16_t value = 1;
+    uint8_t first_byte;
+    std::memcpy(&first_byte, &value, 1);
+    return first_byte == 1;
+}
+
+size_t Align(size_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+size_t ScalarSize(ScalarType type) {
+    return type == ScalarType::Float32 ? sizeof(float) : sizeof(double);
+}
+
+inline uint64_t RotateLeft(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+/// A fast 64 bit hash of \p size bytes of \p data, processing four 64 bit
+/// words per step in independent lanes, to detect corrupted data.
+uint64_t ComputeChecksum(const char *data, size_t size) {
+    constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    uint64_t lanes[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+    size_t pos = 0;
+    for (; pos + 32 <= size; pos += 32) {
+        for (int l = 0; l < 4; l++) {
+            uint64_t word;
+            std::memcpy(&word, data + pos + 8 * l, 8);
+            lanes[l] = RotateLeft(lanes[l] + word * kPrime2, 31) * kPrime1;
+        }
+    }
+    uint64_t hash = size;
+    for (int l = 0; l < 4; l++) {
+        hash = (hash ^ RotateLeft(lanes[l], 7 * l + 1)) * kPrime1 + kPrime2;
+    }
+    for (; pos < size; pos++) {
+        hash = RotateLeft(hash ^ (uint8_t(data[pos]) * kPrime1), 11) * kPrime2;
+    }
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+size_t NumBlocks(size_t size) { return (size + kBlockSize - 1) / kBlockSize; }
+
+/// Compresses \p size bytes of \p data with LZF, in blocks of kBlockSize
+/// bytes, into \p out: the stored sizes of the blocks as 64 bit integers
+/// followed by the blocks. Blocks that do not shrink are stored as is.
+void CompressBlocks(const char *data, size_t size, std::vector<char> &out) {
+    const int64_t n_blocks = static_cast<int64_t>(NumBlocks(size));
+    std::vector<std::vector<char>> blocks(n_blocks);
+    std::vector<uint64_t> block_sizes(n_blocks);
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+    for (int64_t b = 0; b < n_blocks; b++) {
+        const char *block = data + b * kBlockSize;
+        const size_t block_size = std::min(kBlockSize, size - b * kBlockSize);
+        std::vector<char> &stored = blocks[b];
+        stored.resize(block_size - 1);
+        const size_t compressed_size = utility::LzfCompress(
+                block, block_size, stored.data(), stored.size());
+        if (compressed_size == 0) {
+            stored.assign(block, block + block_size);
+        } else {
+            stored.resize(compressed_size);
+        }
+        block_sizes[b] = stored.size();
+    }
+    out.clear();
+    out.insert(out.end(), reinterpret_cast<const char *>(block_sizes.data()),
+               reinterpret_cast<const char *>(block_sizes.data() + n_blocks));
+    for (const std::vector<char> &stored : blocks) {
+        out.insert(out.end(), stored.begin(), stored.end());
+    }
+}
+
+/// Checks that the \p size bytes of compressed blocks in \p data hold
+/// \p values_size bytes of values.
+bool ValidateBlocks(const char *data, size_t size, size_t values_size) {
+    const size_t n_blocks = NumBlocks(values_size);
+    if (n_blocks > size / sizeof(uint64_t)) {
+        return false;
+    }
+    size_t stored_size = n_blocks * sizeof(uint64_t);
+    for (size_t b = 0; b < n_blocks; b++) {
+        uint64_t block_size;
+        std::memcpy(&block_size, data + b * sizeof(uint64_t),
+                    sizeof(uint64_t));
+        if (block_size == 0 || block_size > kBlockSize ||
+            block_size > size - stored_size) {
+            return false;
+        }
+        stored_size += block_size;
+    }
+    return stored_size == size;
+}
+
+inline void ConvertFloats(const char *data, int64_t n, double *out) {
+    for (int64_t i = 0; i < n; i++) {
+        float value;
+        std::memcpy(&value, data + i * sizeof(float), sizeof(float));
+        out[i] = value;
+    }
+}
+
+/// Decompresses the blocks of \p array, in parallel, into the \p n values of
+/// \p out.
+bool CopyCompressedArray(const StoredArray &array, int64_t n, double *out) {
+    const size_t scalar_size = ScalarSize(array.type);
+    const size_t size = n * scalar_size;
+    const int64_t n_blocks = static_cast<int64_t>(NumBlocks(size));
+    std::vector<uint64_t> block_sizes(n_blocks);
+    std::memcpy(block_sizes.data(), array.data, n_blocks * sizeof(uint64_t));
+    std::vector<size_t> block_offsets(n_blocks);
+    size_t offset = n_blocks * sizeof(uint64_t);
+    for (int64_t b = 0; b < n_blocks; b++) {
+        block_offsets[b] = offset;
+        offset += block_sizes[b];
+    }
+    std::atomic<bool> success(true);
+#pragma omp parallel num_threads(utility::EstimateMaxThreads())
+    {
+        // Float blocks are decompressed here, then converted.
+        std::vector<char> buffer;
+#pragma omp for schedule(static)
+        for (int64_t b = 0; b < n_blocks; b++) {
+            const size_t block_size =
+                    std::min(kBlockSize, size - b * kBlockSize);
+            char *out_block = reinterpret_cast<char *>(out) + b * kBlockSize;
+            const char *values = array.data + block_offsets[b];
+            if (block_sizes[b] != block_size) {
+                char *block = out_block;
+                if (array.type == ScalarType::Float32) {
+                    buffer.resize(kBlockSize);
+                    block = buffer.data();
+                }
+                if (utility::LzfDecompress(values, block_sizes[b], block,
+                                           block_size) != block_size) {
+                    success = false;
+                    continue;
+                }
+                values = block;
+            }
+            if (array.type == ScalarType::Float32) {
+                ConvertFloats(values, block_size / scalar_size,
+                              out + b * (kBlockSize / scalar_size));
+            } else if (values != out_block) {
+                std::memcpy(out_block, values, block_size);
+            }
+        }
+    }
+    return success;
+}
+
+}  // unnamed namespace
+/// @endcond
+
+bool WriteArrays(const std::vector<ArrayToWrite> &arrays,
+                 bool write_checksum,
+                 const std::function<bool(const char *, size_t)> &write) {
+    if (!IsLittleEndianHost()) {
+        utility::LogWarning("Big endian hosts are not supported.");
+        return false;
+    }
+    // Float arrays are converted and compressed arrays are compressed up
+    // front, the others are written in place.
+    std::vector<std::vector<float>> converted(arrays.size());
+    std::vector<std::vector<char>> compressed(arrays.size());
+    std::vector<const char *> values(arrays.size());
+    std::vector<ArrayEntry> entries(arrays.size());
+    size_t offset =
+            Align(sizeof(FileHeader) + sizeof(ArrayEntry) * arrays.size());
+    for (size_t a = 0; a < arrays.size(); a++) {
+        const ArrayToWrite &array = arrays[a];
+        const int64_t n = array.rows * array.cols;
+        if (array.type == ScalarType::Float32) {
+            std::vector<float> &out = converted[a];
+            out.resize(n);
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+            for (int64_t i = 0; i < n; i++) {
+                out[i] = static_cast<float>(array.values[i]);
+            }
+            values[a] = reinterpret_cast<const char *>(out.data());
+        } else {
+            values[a] = reinterpret_cast<const char *>(array.values);
+        }
+        ArrayEntry &entry = entries[a];
+        std::memset(&entry, 0, sizeof(entry));
+        std::strncpy(entry.name, array.name.c_str(), sizeof(entry.name) - 1);
+        entry.type = static_cast<uint32_t>(array.type);
+        entry.rows = array.rows;
+        entry.cols = array.cols;
+        entry.offset = offset;
+        entry.size = n * ScalarSize(array.type);
+        if (array.compressed) {
+            CompressBlocks(values[a], entry.size, compressed[a]);
+            std::vector<float>().swap(converted[a]);
+            values[a] = compressed[a].data();
+            entry.compression = kCompressionLZF;
+            entry.size = compressed[a].size();
+        }
+        entry.checksum = write_checksum
+                                 ? ComputeChecksum(values[a], entry.size)
+                                 : 0;
+        offset = Align(offset + entry.size);
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.num_arrays = static_cast<uint32_t>(arrays.size());
+    header.flags = write_checksum ? kFlagChecksum : 0;
+    const char padding[kAlignment] = {};
+    size_t written = sizeof(header) + sizeof(ArrayEntry) * entries.size();
+    if (!write(reinterpret_cast<const char *>(&header), sizeof(header)) ||
+        !write(reinterpret_cast<const char *>(entries.data()),
+               sizeof(ArrayEntry) * entries.size())) {
+        return false;
+    }
+    for (size_t a = 0; a < arrays.size(); a++) {
+        if (!write(padding, entries[a].offset - written) ||
+            !write(values[a], entries[a].size)) {
+            return false;
+        }
+        written = entries[a].offset + entries[a].size;
+    }
+    return true;
+}
+
+bool ReadArrays(const char *data,
+                size_t size,
+                const std::string &what,
+                std::vector<StoredArray> &arrays) {
+    arrays.clear();
+    if (!IsLittleEndianHost()) {
+        utility::LogWarning("{}: big endian hosts are not supported.", what);
+        return false;
+    }
+    FileHeader header;
+    if (size < sizeof(header)) {
+        utility::LogWarning("{}: not a tiny3d binary file.", what);
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        utility::LogWarning("{}: not a tiny3d binary file.", what);
+        return false;
+    }
+    if (header.version != kVersion) {
+        utility::LogWarning("{}: unsupported version {:d}.", what,
+                            header.version);
+        return false;
+    }
+    if (header.num_arrays > (size - sizeof(header)) / sizeof(ArrayEntry)) {
+        utility::LogWarning("{}: truncated file.", what);
+        return false;
+    }
+    for (uint32_t a = 0; a < header.num_arrays; a++) {
+        ArrayEntry entry;
+        std::memcpy(&entry, data + sizeof(header) + a * sizeof(entry),
+                    sizeof(entry));
+        entry.name[sizeof(entry.name) - 1] = '\0';
+        if (entry.type > static_cast<uint32_t>(ScalarType::Float32) ||
+            entry.compression > kCompressionLZF || entry.rows < 0 ||
+            entry.cols < 0) {
+            utility::LogWarning("{}: unsupported array {}.", what, entry.name);
+            return false;
+        }
+        const ScalarType type = static_cast<ScalarType>(entry.type);
+        const bool compressed = entry.compression == kCompressionLZF;
+        // Compressed values may be larger than the container, their number is
+        // only bounded to avoid overflows.
+        const int64_t max_values =
+                compressed ? INT64_MAX / static_cast<int64_t>(sizeof(double))
+                           : static_cast<int64_t>(size);
+        bool valid =
+                (entry.rows == 0 || entry.cols <= max_values / entry.rows) &&
+                entry.offset <= size && entry.size <= size - entry.offset;
+        if (valid) {
+            const size_t values_size =
+                    entry.rows * entry.cols * ScalarSize(type);
+            valid = compressed ? ValidateBlocks(data + entry.offset, entry.size,
+                                                values_size)
+                               : entry.size == values_size;
+        }
+        if (!valid) {
+            utility::LogWarning("{}: truncated or corrupted array {}.", what,
+                                entry.name);
+            return false;
+        }
+        if ((header.flags & kFlagChecksum) &&
+            ComputeChecksum(data + entry.offset, entry.size) !=
+                    entry.checksum) {
+            utility::LogWarning("{}: checksum mismatch of array {}.", what,
+                                entry.name);
+            return false;
+        }
+        arrays.push_back({entry.name, entry.rows, entry.cols, type, compressed,
+                          data + entry.offset, entry.size});
+    }
+    return true;
+}
+
+const StoredArray *FindArray(const std::vector<StoredArray> &arrays,
+                             const std::string &name) {
+    for (const StoredArray &array : arrays) {
+        if (array.name == name) {
+            return &array;
+        }
+    }
+    return nullptr;
+}
+
+bool CopyArray(const StoredArray &array, double *out) {
+    const int64_t n = array.rows * array.cols;
+    if (n == 0) {
+        return true;
+    }
+    if (array.compressed) {
+        return CopyCompressedArray(array, n, out);
+    }
+    if (array.type == ScalarType::Float64) {
+        std::memcpy(out, array.data, n * sizeof(double));
+        return true;
+    }
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+    for (int64_t i = 0; i < n; i++) {
+        float value;
+        std::memcpy(&value, array.data + i * sizeof(float), sizeof(float));
+        out[i] = value;
+    }
+    return true;
+}
+
+}  // namespace binary_container
+}  // namespace io
+}  // namespace tiny3d
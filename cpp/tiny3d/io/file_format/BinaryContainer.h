@@ -0,0 +1,82 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace tiny3d {
+namespace io {
+namespace binary_container {
+
+/// Storage type of the values of an array.
+enum class ScalarType : uint32_t { Float64 = 0, Float32 = 1 };
+
+/// \struct ArrayToWrite
+///
+/// \brief A matrix of doubles to store, column major: \p cols records of
+/// \p rows values, e.g. 3 x N for the points of a point cloud.
+struct ArrayToWrite {
+    std::string name;
+    int64_t rows;
+    int64_t cols;
+    const double *values;
+    ScalarType type;
+    /// Whether to compress the values with LZF, in independent blocks that
+    /// are compressed and decompressed in parallel.
+    bool compressed = false;
+};
+
+/// \struct StoredArray
+///
+/// \brief An array of a container, referring to the container data.
+struct StoredArray {
+    std::string name;
+    int64_t rows;
+    int64_t cols;
+    ScalarType type;
+    bool compressed;
+    /// The rows * cols values, or their compressed blocks, aligned to 64 bytes
+    /// relative to the beginning of the container.
+    const char *data;
+    /// Size of the stored data in bytes.
+    size_t size;
+};
+
+/// Writes the container of \p arrays and passes it, in order, to \p write,
+/// which returns false on failure. The container is a header and a table of
+/// the arrays followed by their little endian values, raw or compressed, each
+/// aligned to 64 bytes, with an optional checksum of every stored array.
+bool WriteArrays(const std::vector<ArrayToWrite> &arrays,
+                 bool write_checksum,
+                 const std::function<bool(const char *, size_t)> &write);
+
+/// Parses the container in \p data and checks its arrays against their
+/// checksums, if any. Returns false, with a warning prefixed by \p what, if
+/// the container is malformed or corrupted.
+bool ReadArrays(const char *data,
+                size_t size,
+                const std::string &what,
+                std::vector<StoredArray> &arrays);
+
+/// Returns the array \p name of \p arrays, or nullptr.
+const StoredArray *FindArray(const std::vector<StoredArray> &arrays,
+                             const std::string &name);
+
+/// Copies the values of \p array into \p out: a single memcpy for double
+/// arrays, a parallel conversion for float arrays, and a parallel
+/// decompression of the blocks of compressed arrays. Returns false if the
+/// compressed data is corrupted.
+bool CopyArray(const StoredArray &array, double *out);
+
+}  // namespace binary_container
+}  // namespace io
+}  // namespace tiny3d
@@ -0,0 +1,427 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/io/file_format/ColumnTextIO.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <vector>
+
+#include "tiny3d/utility/Eigen.h"
+#include "tiny3d/utility/FileSystem.h"
+#include "tiny3d/utility/Logging.h"
+#include "tiny3d/utility/Parallel.h"
+#include "tiny3d/utility/ProgressReporters.h"
+
+namespace tiny3d {
+namespace io {
+namespace column_text {
+
+/// @cond
+namespace {
+
+/// Maximum number of columns of a layout.
+constexpr int kMaxColumns = 16;
+
+/// Size of the chunks of text that are parsed in parallel.
+constexpr size_t kChunkSize = 1 << 22;
+
+struct ChunkAttributes {
+    std::vector<Eigen::Vector3d> points;
+    std::vector<Eigen::Vector3d> normals;
+    std::vector<Eigen::Vector3d> colors;
+};
+
+/// Returns the end of the line starting at \p line, its line break or \p end.
+inline const char *FindLineEnd(const char *line, const char *end) {
+    const char *line_end =
+            static_cast<const char *>(std::memchr(line, '\n', end - line));
+    return line_end == nullptr ? end : line_end;
+}
+
+/// Parses the layout.num_columns leading numbers of the line [line, line_end)
+/// into \p values. Returns false if the line holds no point.
+inline bool ParseLine(const char *line,
+                      const char *line_end,
+                      const ColumnLayout &layout,
+                      double *values) {
+    int n = 0;
+    while (n < layout.num_columns && ParseDouble(line, line_end, values[n])) {
+        n++;
+    }
+    return n == layout.num_columns;
+}
+
+/// Returns the number of lines of [begin, end) that hold a point.
+int64_t CountPoints(const char *begin,
+                    const char *end,
+                    const ColumnLayout &layout) {
+    double values[kMaxColumns];
+    int64_t n_points = 0;
+    for (const char *line = begin; line < end;) {
+        const char *line_end = FindLineEnd(line, end);
+        if (ParseLine(line, line_end, layout, values)) {
+            n_points++;
+        }
+        line = line_end + 1;
+    }
+    return n_points;
+}
+
+/// Splits the \p size bytes of \p data into chunks of about kChunkSize bytes
+/// at line boundaries. Returns the offsets of the chunks and \p size.
+std::vector<size_t> SplitLines(const char *data, size_t size) {
+    const size_t n_chunks = (size + kChunkSize - 1) / kChunkSize;
+    // Chunk c starts after the first line break at or after c * kChunkSize.
+    std::vector<size_t> chunk_begins(n_chunks + 1, size);
+    for (size_t c = 0; c < n_chunks; c++) {
+        size_t begin = c * kChunkSize;
+        if (c > 0) {
+            const char *line_break = static_cast<const char *>(
+                    std::memchr(data + begin - 1, '\n', size - begin + 1));
+            begin = line_break ? line_break - data + 1 : size;
+        }
+        chunk_begins[c] = std::max(begin, c > 0 ? chunk_begins[c - 1] : 0);
+    }
+    return chunk_begins;
+}
+
+/// Parses the lines in [begin, end) and appends the attributes of every line
+/// starting with layout.num_columns numbers, other lines are skipped.
+void ParseLines(const char *begin,
+                const char *end,
+                const ColumnLayout &layout,
+                ChunkAttributes &attributes) {
+    const double color_divisor = layout.color_uint8 ? 255.0 : 1.0;
+    double values[kMaxColumns];
+    const char *line = begin;
+    while (line < end) {
+        const char *line_end = FindLineEnd(line, end);
+        if (ParseLine(line, line_end, layout, values)) {
+            attributes.points.emplace_back(values[0], values[1], values[2]);
+            if (layout.normal_column >= 0) {
+                const double *normal = values + layout.normal_column;
+                attributes.normals.emplace_back(normal[0], normal[1],
+                                                normal[2]);
+            }
+            if (layout.color_column >= 0) {
+                const double *color = values + layout.color_column;
+                attributes.colors.emplace_back(color[0] / color_divisor,
+                                               color[1] / color_divisor,
+                                               color[2] / color_divisor);
+            }
+        }
+        line = line_end + 1;
+    }
+}
+
+/// Moves the attributes of all chunks into \p attribute, in order.
+void Concatenate(std::vector<ChunkAttributes> &chunks,
+                 std::vector<Eigen::Vector3d> ChunkAttributes::*member,
+                 std::vector<Eigen::Vector3d> &attribute) {
+    const int n_chunks = static_cast<int>(chunks.size());
+    std::vector<size_t> offsets(n_chunks + 1, 0);
+    for (int c = 0; c < n_chunks; c++) {
+        offsets[c + 1] = offsets[c] + (chunks[c].*member).size();
+    }
+    attribute.resize(offsets[n_chunks]);
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+    for (int c = 0; c < n_chunks; c++) {
+        std::copy((chunks[c].*member).begin(), (chunks[c].*member).end(),
+                  attribute.begin() + offsets[c]);
+        std::vector<Eigen::Vector3d>().swap(chunks[c].*member);
+    }
+}
+
+/// Appends \p value to \p text at \p size with \p precision digits after the
+/// decimal point, or in the shortest form that reads back exactly if
+/// \p precision is negative.
+void AppendDouble(std::vector<char> &text,
+                  size_t &size,
+                  double value,
+                  int precision) {
+    // The longest fixed notation of a double has 309 integer digits.
+    const size_t max_length = 328 + std::max(precision, 0);
+    if (text.size() < size + max_length) {
+        text.resize(std::max(2 * text.size(), size + max_length));
+    }
+    char *first = text.data() + size;
+    char *last = text.data() + text.size();
+    const std::to_chars_result result =
+            precision < 0 ? std::to_chars(first, last, value)
+                          : std::to_chars(first, last, value,
+                                          std::chars_format::fixed, precision);
+    size = result.ptr - text.data();
+}
+
+void AppendInt(std::vector<char> &text, size_t &size, int value) {
+    constexpr size_t kMaxLength = 12;
+    if (text.size() < size + kMaxLength) {
+        text.resize(std::max(2 * text.size(), size + kMaxLength));
+    }
+    size = std::to_chars(text.data() + size, text.data() + text.size(), value)
+                   .ptr -
+           text.data();
+}
+
+void AppendChar(std::vector<char> &text, size_t &size, char value) {
+    if (text.size() < size + 1) {
+        text.resize(std::max(2 * text.size(), size + 1));
+    }
+    text[size++] = value;
+}
+
+}  // unnamed namespace
+/// @endcond
+
+int CountColumns(const char *line, const char *end) {
+    const char *line_end =
+            static_cast<const char *>(std::memchr(line, '\n', end - line));
+    if (line_end == nullptr) {
+        line_end = end;
+    }
+    int n = 0;
+    double value;
+    while (ParseDouble(line, line_end, value)) {
+        n++;
+    }
+    return n;
+}
+
+bool ReadPointCloud(const char *data,
+                    size_t size,
+                    const ColumnLayout &layout,
+                    geometry::PointCloud &pointcloud,
+                    const ReadPointCloudOption &params) {
+    if (layout.num_columns < 3 || layout.num_columns > kMaxColumns) {
+        utility::LogError("Invalid number of columns {:d}.",
+                          layout.num_columns);
+    }
+    utility::CountingProgressReporter reporter(params.update_progress);
+    reporter.SetTotal(static_cast<int64_t>(size));
+
+    const std::vector<size_t> chunk_begins = SplitLines(data, size);
+    const int n_chunks = static_cast<int>(chunk_begins.size() - 1);
+
+    std::vector<ChunkAttributes> chunks(n_chunks);
+    constexpr int kBatchSize = 64;
+    for (int batch_begin = 0; batch_begin < n_chunks;
+         batch_begin += kBatchSize) {
+        const int batch_end = std::min(batch_begin + kBatchSize, n_chunks);
+#pragma omp parallel for schedule(dynamic, 1) \
+        num_threads(utility::EstimateMaxThreads())
+        for (int c = batch_begin; c < batch_end; c++) {
+            ParseLines(data + chunk_begins[c], data + chunk_begins[c + 1],
+                       layout, chunks[c]);
+        }
+        reporter.Update(static_cast<int64_t>(chunk_begins[batch_end]));
+    }
+
+    pointcloud.Clear();
+    Concatenate(chunks, &ChunkAttributes::points, pointcloud.points_);
+    Concatenate(chunks, &ChunkAttributes::normals, pointcloud.normals_);
+    Concatenate(chunks, &ChunkAttributes::colors, pointcloud.colors_);
+    reporter.Finish();
+    return true;
+}
+
+bool WritePointCloud(const geometry::PointCloud &pointcloud,
+                     const ColumnLayout &layout,
+                     const WritePointCloudOption &params,
+                     const std::function<bool(const char *, size_t)> &write) {
+    utility::CountingProgressReporter reporter(params.update_progress);
+    const int64_t n_points = static_cast<int64_t>(pointcloud.points_.size());
+    reporter.SetTotal(n_points);
+
+    constexpr int64_t kBlockSize = 1 << 15;
+    const int n_threads = utility::EstimateMaxThreads();
+    std::vector<std::vector<char>> block_texts(n_threads);
+    std::vector<size_t> block_sizes(n_threads);
+    for (int64_t batch_begin = 0; batch_begin < n_points;
+         batch_begin += kBlockSize * n_threads) {
+        const int n_blocks = static_cast<int>(std::min<int64_t>(
+                n_threads,
+                (n_points - batch_begin + kBlockSize - 1) / kBlockSize));
+#pragma omp parallel for schedule(static, 1) num_threads(n_threads)
+        for (int b = 0; b < n_blocks; b++) {
+            const int64_t begin = batch_begin + b * kBlockSize;
+            const int64_t end = std::min(begin + kBlockSize, n_points);
+            std::vector<char> &text = block_texts[b];
+            size_t size = 0;
+            for (int64_t i = begin; i < end; i++) {
+                for (int c = 0; c < layout.num_columns; c++) {
+                    if (c > 0) {
+                        AppendChar(text, size, ' ');
+                    }
+                    if (c < 3) {
+                        AppendDouble(text, size, pointcloud.points_[i](c),
+                                     params.precision);
+                    } else if (layout.normal_column >= 0 &&
+                               c >= layout.normal_column &&
+                               c < layout.normal_column + 3) {
+                        AppendDouble(text, size,
+                                     pointcloud.normals_[i](
+                                             c - layout.normal_column),
+                                     params.precision);
+                    } else if (layout.color_column >= 0 &&
+                               c >= layout.color_column &&
+                               c < layout.color_column + 3) {
+                        const int k = c - layout.color_column;
+                        if (layout.color_uint8) {
+                            AppendInt(text, size,
+                                      utility::ColorToUint8(
+                                              pointcloud.colors_[i])(k));
+                        } else {
+                            AppendDouble(text, size, pointcloud.colors_[i](k),
+                                         params.precision);
+                        }
+                    } else {
+                        AppendInt(text, size, 0);
+                    }
+                }
+                AppendChar(text, size, '\n');
+            }
+            block_sizes[b] = size;
+        }
+        for (int b = 0; b < n_blocks; b++) {
+            if (!write(block_texts[b].data(), block_sizes[b])) {
+                return false;
+            }
+        }
+        reporter.Update(
+                std::min(batch_begin + kBlockSize * n_threads, n_points));
+    }
+    reporter.Finish();
+    return true;
+}
+
+/// @cond
+namespace {
+
+/// Reads the points of a text file in chunks of lines. The file is indexed,
+/// i.e. the points of every chunk of kChunkSize bytes are counted in parallel,
+/// on the first call to GetPointCount or Seek.
+class ColumnTextPointCloudReader : public PointCloudReader {
+public:
+    ColumnTextPointCloudReader(const ColumnLayout &layout,
+                               const std::string &format)
+        : layout_(layout), format_(format) {}
+
+    bool Open(const std::string &filename) {
+        if (!file_.Open(filename)) {
+            utility::LogWarning("Read {} failed: unable to open file: {}",
+                                format_, filename);
+            return false;
+        }
+        return true;
+    }
+
+    int64_t GetPointCount() override {
+        if (index_points_.empty()) {
+            BuildIndex();
+        }
+        return index_points_.back();
+    }
+
+    bool Seek(int64_t index) override {
+        if (index < 0 || index > GetPointCount()) {
+            utility::LogWarning("Read {} failed: point {:d} out of range.",
+                                format_, index);
+            return false;
+        }
+        const size_t chunk =
+                std::upper_bound(index_points_.begin(), index_points_.end(),
+                                 index) -
+                index_points_.begin() - 1;
+        const char *data = file_.GetData();
+        const char *end = data + file_.GetSize();
+        const char *line = data + index_offsets_[chunk];
+        double values[kMaxColumns];
+        int64_t skip = index - index_points_[chunk];
+        while (skip > 0 && line < end) {
+            const char *line_end = FindLineEnd(line, end);
+            if (ParseLine(line, line_end, layout_, values)) {
+                skip--;
+            }
+            line = line_end + 1;
+        }
+        offset_ = line - data;
+        position_ = index;
+        return true;
+    }
+
+    bool ReadChunk(int64_t max_points, geometry::PointCloud &chunk) override {
+        chunk.Clear();
+        const char *data = file_.GetData();
+        const size_t size = file_.GetSize();
+        // Lines without a point are skipped, the next max_points lines may
+        // hold fewer points.
+        while (chunk.IsEmpty() && offset_ < size && max_points > 0) {
+            size_t end = offset_;
+            for (int64_t i = 0; i < max_points && end < size; i++) {
+                end = FindLineEnd(data + end, data + size) - data + 1;
+            }
+            end = std::min(end, size);
+            ReadPointCloud(data + offset_, end - offset_, layout_, chunk,
+                           ReadPointCloudOption());
+            offset_ = end;
+        }
+        position_ += static_cast<int64_t>(chunk.points_.size());
+        return !chunk.IsEmpty();
+    }
+
+private:
+    void BuildIndex() {
+        const std::vector<size_t> chunk_begins =
+                SplitLines(file_.GetData(), file_.GetSize());
+        const int64_t n_chunks =
+                static_cast<int64_t>(chunk_begins.size()) - 1;
+        std::vector<int64_t> counts(n_chunks);
+#pragma omp parallel for schedule(dynamic, 1) \
+        num_threads(utility::EstimateMaxThreads())
+        for (int64_t c = 0; c < n_chunks; c++) {
+            counts[c] = CountPoints(file_.GetData() + chunk_begins[c],
+                                    file_.GetData() + chunk_begins[c + 1],
+                                    layout_);
+        }
+        index_offsets_ = chunk_begins;
+        index_points_.assign(n_chunks + 1, 0);
+        for (int64_t c = 0; c < n_chunks; c++) {
+            index_points_[c + 1] = index_points_[c] + counts[c];
+        }
+    }
+
+    utility::filesystem::MappedFile file_;
+    ColumnLayout layout_;
+    std::string format_;
+    /// Byte offset of the next line to read.
+    size_t offset_ = 0;
+    /// Byte offset of every indexed chunk and the index of its first point,
+    /// followed by the size and the number of points of the file.
+    std::vector<size_t> index_offsets_;
+    std::vector<int64_t> index_points_;
+};
+
+}  // unnamed namespace
+/// @endcond
+
+std::unique_ptr<PointCloudReader> OpenPointCloudReader(
+        const std::string &filename,
+        const ColumnLayout &layout,
+        const std::string &format) {
+    auto reader = std::make_unique<ColumnTextPointCloudReader>(layout, format);
+    if (!reader->Open(filename)) {
+        return nullptr;
+    }
+    return reader;
+}
+
+}  // namespace column_text
+}  // namespace io
+}  // namespace tiny3d
@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <functional>
+
+#include "tiny3d/geometry/PointCloud.h"
+#include "tiny3d/io/PointCloudIO.h"
+#include "tiny3d/io/PointCloudReader.h"
+
+namespace tiny3d {
+namespace io {
+namespace column_text {
+
+/// \struct ColumnLayout
+///
+/// \brief Layout of the blank separated numeric columns of the text point
+/// cloud formats (XYZ, XYZN, XYZRGB, PTS). The coordinates are the first
+/// three columns.
+struct ColumnLayout {
+    /// Number of columns. Lines with fewer leading numbers are skipped when
+    /// reading, e.g. headers and comments; further columns are ignored.
+    int num_columns = 3;
+    /// First of the three normal columns, or -1.
+    int normal_column = -1;
+    /// First of the three color columns, or -1.
+    int color_column = -1;
+    /// Colors are stored as integers in [0, 255] instead of [0, 1].
+    bool color_uint8 = false;
+};
+
+/// Parses a floating point number at \p p, after optional blanks, and
+/// advances \p p past it. Accepts what sscanf("%lf") accepts for decimal
+/// numbers, including a leading '+'.
+inline bool ParseDouble(const char *&p, const char *end, double &value) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\v' ||
+                       *p == '\f')) {
+        p++;
+    }
+    if (p < end && *p == '+') {
+        p++;
+    }
+    const std::from_chars_result result = std::from_chars(p, end, value);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    p = result.ptr;
+    return true;
+}
+
+/// Returns the number of leading blank separated numbers of the line starting
+/// at \p line, which ends at the first line break or at \p end.
+int CountColumns(const char *line, const char *end);
+
+/// Parses the lines of \p data in parallel, in chunks split at line
+/// boundaries, and replaces the content of \p pointcloud.
+bool ReadPointCloud(const char *data,
+                    size_t size,
+                    const ColumnLayout &layout,
+                    geometry::PointCloud &pointcloud,
+                    const ReadPointCloudOption &params);
+
+/// Formats the points of \p pointcloud in parallel blocks and passes the text
+/// of every block, in order, to \p write, which returns false on failure.
+/// Columns that are neither coordinates, normals nor colors are written as 0.
+/// Coordinates and normals, as well as colors unless stored as integers, are
+/// written with WritePointCloudOption::precision.
+bool WritePointCloud(const geometry::PointCloud &pointcloud,
+                     const ColumnLayout &layout,
+                     const WritePointCloudOption &params,
+                     const std::function<bool(const char *, size_t)> &write);
+
+/// Opens \p filename for reading its points in chunks of lines. \p format
+/// names the format in warnings.
+std::unique_ptr<PointCloudReader> OpenPointCloudReader(
+        const std::string &filename,
+        const ColumnLayout &layout,
+        const std::string &format);
+
+}  // namespace column_text
+}  // namespace io
+}  // namespace tiny3d
@@ -0,0 +1,265 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "tiny3d/io/FileFormatIO.h"
+#include "tiny3d/io/PointCloudIO.h"
+#include "tiny3d/utility/FileSystem.h"
+#include "tiny3d/utility/Logging.h"
+#include "tiny3d/utility/Parallel.h"
+#include "tiny3d/utility/ProgressReporters.h"
+
+// References for LAS file IO
+// https://www.asprs.org/wp-content/uploads/2019/07/LAS_1_4_r15.pdf
+// https://www.asprs.org/a/society/committees/standards/asprs_las_format_v12.pdf
+
+namespace tiny3d {
+namespace io {
+
+/// @cond
+namespace {
+
+bool IsLittleEndianHost() {
+    const uint16_t value = 1;
+    uint8_t first_byte;
+    std::memcpy(&first_byte, &value, 1);
+    return first_byte == 1;
+}
+
+/// Minimum record length and offset of the RGB values, -1 if none, of the
+/// point data record formats 0 to 10.
+constexpr int kLASNumPointFormats = 11;
+constexpr size_t kLASMinRecordLength[kLASNumPointFormats] = {
+        20, 28, 26, 34, 57, 63, 30, 36, 38, 59, 67};
+constexpr int kLASColorOffset[kLASNumPointFormats] = {-1, -1, 20, 28, -1, 28,
+                                                      -1, 30, 30, -1, 30};
+
+/// Size of the public header block of LAS 1.0-1.2, and of LAS 1.4 which adds
+/// a 64 bit number of point records.
+constexpr size_t kLASHeaderSize = 227;
+constexpr size_t kLAS14HeaderSize = 375;
+
+struct LASHeader {
+    int version_major;
+    int version_minor;
+    int point_format;
+    size_t record_length;
+    /// Byte offset of the first point record.
+    size_t point_offset;
+    int64_t num_points;
+    double scale[3];
+    double offset[3];
+};
+
+template <typename T>
+T ReadLASValue(const char *data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+/// Parses the public header block at the beginning of \p data. Returns false,
+/// with a warning, if the file is not a supported LAS file.
+bool ParseLASHeader(const char *data, size_t size, LASHeader &header) {
+    if (size < kLASHeaderSize || std::memcmp(data, "LASF", 4) != 0) {
+        utility::LogWarning("Read LAS failed: not a LAS file.");
+        return false;
+    }
+    header.version_major = ReadLASValue<uint8_t>(data, 24);
+    header.version_minor = ReadLASValue<uint8_t>(data, 25);
+    const size_t header_size = ReadLASValue<uint16_t>(data, 94);
+    header.point_offset = ReadLASValue<uint32_t>(data, 96);
+    const int point_format = ReadLASValue<uint8_t>(data, 104);
+    header.record_length = ReadLASValue<uint16_t>(data, 105);
+    header.num_points = ReadLASValue<uint32_t>(data, 107);
+    for (int c = 0; c < 3; c++) {
+        header.scale[c] = ReadLASValue<double>(data, 131 + 8 * c);
+        header.offset[c] = ReadLASValue<double>(data, 155 + 8 * c);
+    }
+    if (header.version_major == 1 && header.version_minor >= 4 &&
+        header_size >= kLAS14HeaderSize && size >= kLAS14HeaderSize) {
+        const uint64_t num_points = ReadLASValue<uint64_t>(data, 247);
+        if (num_points > 0) {
+            header.num_points = static_cast<int64_t>(num_points);
+        }
+    }
+    // LASzip marks compressed point data with the high bits of the format.
+    if (point_format & 0xc0) {
+        utility::LogWarning(
+                "Read LAS failed: compressed (LAZ) point data is not "
+                "supported.");
+        return false;
+    }
+    header.point_format = point_format;
+    if (header.point_format >= kLASNumPointFormats) {
+        utility::LogWarning(
+                "Read LAS failed: unsupported point data record format {:d}.",
+                header.point_format);
+        return false;
+    }
+    if (header.record_length < kLASMinRecordLength[header.point_format]) {
+        utility::LogWarning(
+                "Read LAS failed: invalid point data record length {:d}.",
+                header.record_length);
+        return false;
+    }
+    if (header.point_offset > size) {
+        utility::LogWarning("Read LAS failed: invalid offset to point data.");
+        return false;
+    }
+    const int64_t available = static_cast<int64_t>(
+            (size - header.point_offset) / header.record_length);
+    if (header.num_points > available) {
+        utility::LogWarning(
+                "Read LAS: the file is truncated, reading {:d} of {:d} "
+                "points.",
+                available, header.num_points);
+        header.num_points = available;
+    }
+    return true;
+}
+
+/// Decodes the point records [first_point, first_point + num_points) of the
+/// LAS file in \p data, clamped to the records of the file.
+bool ReadLAS(const char *data,
+             size_t size,
+             int64_t first_point,
+             int64_t num_points,
+             geometry::PointCloud &pointcloud,
+             const ReadPointCloudOption &params) {
+    if (!IsLittleEndianHost()) {
+        utility::LogWarning(
+                "Read LAS failed: big endian hosts are not supported.");
+        return false;
+    }
+    LASHeader header;
+    if (!ParseLASHeader(data, size, header)) {
+        return false;
+    }
+    first_point =
+            std::min(std::max<int64_t>(first_point, 0), header.num_points);
+    const int64_t n_points = std::min(std::max<int64_t>(num_points, 0),
+                                      header.num_points - first_point);
+    const size_t stride = header.record_length;
+    const char *records = data + header.point_offset + first_point * stride;
+    const int color_offset = kLASColorOffset[header.point_format];
+    const bool has_colors = color_offset >= 0;
+    pointcloud.Clear();
+    pointcloud.points_.resize(n_points);
+    pointcloud.colors_.resize(has_colors ? n_points : 0);
+
+    utility::CountingProgressReporter reporter(params.update_progress);
+    reporter.SetTotal(n_points);
+
+    // Records are decoded in chunks, in parallel, and progress is reported
+    // between batches of chunks. Only the pages of the mapping holding the
+    // requested records are read.
+    const Eigen::Vector3d scale(header.scale[0], header.scale[1],
+                                header.scale[2]);
+    const Eigen::Vector3d offset(header.offset[0], header.offset[1],
+                                 header.offset[2]);
+    constexpr int64_t kChunkSize = 1 << 14;
+    constexpr int64_t kBatchSize = kChunkSize * 256;
+    for (int64_t batch_begin = 0; batch_begin < n_points;
+         batch_begin += kBatchSize) {
+        const int64_t batch_end = std::min(batch_begin + kBatchSize, n_points);
+        const int64_t n_chunks =
+                (batch_end - batch_begin + kChunkSize - 1) / kChunkSize;
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+        for (int64_t chunk = 0; chunk < n_chunks; chunk++) {
+            const int64_t begin = batch_begin + chunk * kChunkSize;
+            const int64_t end = std::min(begin + kChunkSize, batch_end);
+            for (int64_t i = begin; i < end; i++) {
+                const char *record = records + i * stride;
+                int32_t xyz[3];
+                std::memcpy(xyz, record, sizeof(xyz));
+                pointcloud.points_[i] =
+                        Eigen::Vector3d(xyz[0], xyz[1], xyz[2])
+                                .cwiseProduct(scale) +
+                        offset;
+                if (has_colors) {
+                    uint16_t rgb[3];
+                    std::memcpy(rgb, record + color_offset, sizeof(rgb));
+                    pointcloud.colors_[i] =
+                            Eigen::Vector3d(rgb[0], rgb[1], rgb[2]) / 65535.0;
+                }
+            }
+        }
+        reporter.Update(batch_end);
+    }
+    reporter.Finish();
+    return true;
+}
+
+}  // unnamed namespace
+/// @endcond
+
+FileGeometry ReadFileGeometryTypeLAS(const std::string &path) {
+    return CONTAINS_POINTS;
+}
+
+int64_t ReadLASPointCount(const std::string &filename) {
+    utility::filesystem::MappedFile file;
+    if (!file.Open(filename)) {
+        utility::LogWarning("Read LAS failed: unable to open file: {}",
+                            filename);
+        return -1;
+    }
+    LASHeader header;
+    if (!ParseLASHeader(file.GetData(), file.GetSize(), header)) {
+        return -1;
+    }
+    return header.num_points;
+}
+
+bool ReadPointCloudRangeFromLAS(const std::string &filename,
+                                int64_t first_point,
+                                int64_t num_points,
+                                geometry::PointCloud &pointcloud,
+                                const ReadPointCloudOption &params) {
+    try {
+        utility::filesystem::MappedFile file;
+        if (!file.Open(filename)) {
+            utility::LogWarning("Read LAS failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        return ReadLAS(file.GetData(), file.GetSize(), first_point,
+                       num_points, pointcloud, params);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read LAS failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool ReadPointCloudFromLAS(const std::string &filename,
+                           geometry::PointCloud &pointcloud,
+                           const ReadPointCloudOption &params) {
+    return ReadPointCloudRangeFromLAS(filename, 0, INT64_MAX, pointcloud,
+                                      params);
+}
+
+bool ReadPointCloudInMemoryFromLAS(const unsigned char *buffer,
+                                   const size_t length,
+                                   geometry::PointCloud &pointcloud,
+                                   const ReadPointCloudOption &params) {
+    try {
+        return ReadLAS(reinterpret_cast<const char *>(buffer), length, 0,
+                       INT64_MAX, pointcloud, params);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read LAS failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+}  // namespace io
+}  // namespace tiny3d
@@ -0,0 +1,803 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tiny3d/io/FileFormatIO.h"
+#include "tiny3d/io/PointCloudIO.h"
+#include "tiny3d/io/file_format/ColumnTextIO.h"
+#include "tiny3d/utility/Compression.h"
+#include "tiny3d/utility/Eigen.h"
+#include "tiny3d/utility/FileSystem.h"
+#include "tiny3d/utility/Logging.h"
+#include "tiny3d/utility/Parallel.h"
+#include "tiny3d/utility/ProgressReporters.h"
+
+// References for PCD file IO
+// https://pointclouds.org/documentation/tutorials/pcd_file_format.html
+
+namespace tiny3d {
+namespace io {
+
+/// @cond
+namespace {
+
+enum class PCDDataType { ASCII, Binary, BinaryCompressed };
+
+struct PCDField {
+    std::string name;
+    /// 'F' (floating point), 'U' (unsigned) or 'I' (signed integer).
+    char type;
+    /// Size of a scalar in bytes.
+    int size;
+    /// Number of scalars of the field.
+    int count;
+    /// Byte offset in a record.
+    size_t offset;
+};
+
+struct PCDHeader {
+    std::vector<PCDField> fields;
+    int64_t points;
+    PCDDataType data_type;
+    /// Size of a record in bytes.
+    size_t point_size;
+    /// Byte offset of the data following the header.
+    size_t data_offset;
+};
+
+/// Parses the header at the beginning of \p data. Returns false if it is not
+/// a well formed PCD header.
+bool ParsePCDHeader(const char *data, size_t size, PCDHeader &header) {
+    header = PCDHeader();
+    std::vector<int> sizes, counts;
+    std::vector<char> types;
+    int64_t width = -1, height = 1;
+    header.points = -1;
+    size_t pos = 0;
+    while (pos < size) {
+        const char *line_end = static_cast<const char *>(
+                std::memchr(data + pos, '\n', size - pos));
+        if (line_end == nullptr) {
+            return false;
+        }
+        std::string line(data + pos, line_end);
+        pos = line_end - data + 1;
+        std::istringstream tokens(line);
+        std::string keyword;
+        if (!(tokens >> keyword) || keyword[0] == '#') {
+            continue;
+        }
+        if (keyword == "FIELDS" || keyword == "COLUMNS") {
+            std::string name;
+            while (tokens >> name) {
+                header.fields.push_back({name, 'F', 4, 1, 0});
+            }
+        } else if (keyword == "SIZE") {
+            int value;
+            while (tokens >> value) {
+                sizes.push_back(value);
+            }
+        } else if (keyword == "TYPE") {
+            char value;
+            while (tokens >> value) {
+                types.push_back(value);
+            }
+        } else if (keyword == "COUNT") {
+            int value;
+            while (tokens >> value) {
+                counts.push_back(value);
+            }
+        } else if (keyword == "WIDTH") {
+            tokens >> width;
+        } else if (keyword == "HEIGHT") {
+            tokens >> height;
+        } else if (keyword == "POINTS") {
+            tokens >> header.points;
+        } else if (keyword == "DATA") {
+            std::string data_type;
+            tokens >> data_type;
+            if (data_type == "ascii") {
+                header.data_type = PCDDataType::ASCII;
+            } else if (data_type == "binary") {
+                header.data_type = PCDDataType::Binary;
+            } else if (data_type == "binary_compressed") {
+                header.data_type = PCDDataType::BinaryCompressed;
+            } else {
+                utility::LogWarning("Read PCD: unknown data type {}.",
+                                    data_type);
+                return false;
+            }
+            header.data_offset = pos;
+            break;
+        }
+        // VERSION and VIEWPOINT are ignored.
+    }
+    const size_t n_fields = header.fields.size();
+    if (header.data_offset == 0 || n_fields == 0 ||
+        sizes.size() != n_fields || types.size() != n_fields ||
+        (!counts.empty() && counts.size() != n_fields)) {
+        return false;
+    }
+    if (header.points < 0) {
+        // WIDTH and HEIGHT come from the file, the product must not
+        // overflow.
+        if (width < 0 || height < 0 ||
+            (height > 0 && width > INT64_MAX / height)) {
+            return false;
+        }
+        header.points = width * height;
+    }
+    header.point_size = 0;
+    for (size_t f = 0; f < n_fields; f++) {
+        PCDField &field = header.fields[f];
+        field.type = types[f];
+        field.size = sizes[f];
+        field.count = counts.empty() ? 1 : counts[f];
+        field.offset = header.point_size;
+        const bool valid_size = field.size == 1 || field.size == 2 ||
+                                field.size == 4 || field.size == 8;
+        if ((field.type != 'F' && field.type != 'U' && field.type != 'I') ||
+            !valid_size || (field.type == 'F' && field.size < 4) ||
+            field.count < 1) {
+            return false;
+        }
+        header.point_size += size_t(field.size) * field.count;
+        // Records are at most 4 GiB, the uncompressed size limit of
+        // binary_compressed data, which also keeps the sum from overflowing.
+        if (header.point_size > UINT32_MAX) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Calls \p function with a value of the C++ type of the scalars of
+/// \p field. Returns false if the type is not supported.
+template <typename Function>
+bool DispatchPCDScalar(const PCDField &field, Function function) {
+    switch (field.type | (field.size << 8)) {
+        case 'F' | (4 << 8):
+            function(float());
+            return true;
+        case 'F' | (8 << 8):
+            function(double());
+            return true;
+        case 'U' | (1 << 8):
+            function(uint8_t());
+            return true;
+        case 'U' | (2 << 8):
+            function(uint16_t());
+            return true;
+        case 'U' | (4 << 8):
+            function(uint32_t());
+            return true;
+        case 'U' | (8 << 8):
+            function(uint64_t());
+            return true;
+        case 'I' | (1 << 8):
+            function(int8_t());
+            return true;
+        case 'I' | (2 << 8):
+            function(int16_t());
+            return true;
+        case 'I' | (4 << 8):
+            function(int32_t());
+            return true;
+        case 'I' | (8 << 8):
+            function(int64_t());
+            return true;
+    }
+    return false;
+}
+
+/// The first scalar of a field for all points: the scalar of point i is at
+/// data + i * stride.
+struct PCDColumn {
+    const PCDField *field;
+    const char *data;
+    size_t stride;
+};
+
+/// Decodes the three columns \p columns of \p n points into \p out in
+/// parallel, reading the scalars in place.
+void DecodePCDVector3(const PCDColumn columns[3],
+                      int64_t n,
+                      std::vector<Eigen::Vector3d> &out) {
+    out.resize(n);
+    const bool same_type = columns[0].field->type == columns[1].field->type &&
+                           columns[0].field->type == columns[2].field->type &&
+                           columns[0].field->size == columns[1].field->size &&
+                           columns[0].field->size == columns[2].field->size;
+    if (same_type) {
+        DispatchPCDScalar(*columns[0].field, [&](auto zero) {
+            using T = decltype(zero);
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+            for (int64_t i = 0; i < n; i++) {
+                T v[3];
+                for (int k = 0; k < 3; k++) {
+                    std::memcpy(&v[k], columns[k].data + i * columns[k].stride,
+                                sizeof(T));
+                }
+                out[i] = Eigen::Vector3d(v[0], v[1], v[2]);
+            }
+        });
+        return;
+    }
+    for (int k = 0; k < 3; k++) {
+        DispatchPCDScalar(*columns[k].field, [&](auto zero) {
+            using T = decltype(zero);
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+            for (int64_t i = 0; i < n; i++) {
+                T v;
+                std::memcpy(&v, columns[k].data + i * columns[k].stride,
+                            sizeof(T));
+                out[i](k) = static_cast<double>(v);
+            }
+        });
+    }
+}
+
+/// Converts a packed rgb(a) value, 0xAARRGGBB, to a color.
+inline Eigen::Vector3d UnpackPCDColor(uint32_t rgb) {
+    return utility::ColorToDouble((rgb >> 16) & 0xff, (rgb >> 8) & 0xff,
+                                  rgb & 0xff);
+}
+
+inline uint32_t PackPCDColor(const Eigen::Vector3d &color) {
+    const Eigen::Vector3uint8 rgb = utility::ColorToUint8(color);
+    return (uint32_t(rgb(0)) << 16) | (uint32_t(rgb(1)) << 8) | rgb(2);
+}
+
+/// Decodes the packed colors of the 4 bytes column \p column of \p n points
+/// into \p out in parallel.
+void DecodePCDColors(const PCDColumn &column,
+                     int64_t n,
+                     std::vector<Eigen::Vector3d> &out) {
+    out.resize(n);
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+    for (int64_t i = 0; i < n; i++) {
+        uint32_t rgb;
+        std::memcpy(&rgb, column.data + i * column.stride, sizeof(rgb));
+        out[i] = UnpackPCDColor(rgb);
+    }
+}
+
+/// Indices of the fields of the point cloud attributes, -1 if missing.
+struct PCDAttributeFields {
+    int points[3];
+    int normals[3];
+    int colors;
+};
+
+PCDAttributeFields FindPCDAttributeFields(const PCDHeader &header) {
+    static const char *const point_names[3] = {"x", "y", "z"};
+    static const char *const normal_names[3] = {"normal_x", "normal_y",
+                                                "normal_z"};
+    PCDAttributeFields attributes;
+    auto find = [&](const char *name) {
+        for (size_t f = 0; f < header.fields.size(); f++) {
+            if (header.fields[f].name == name) {
+                return static_cast<int>(f);
+            }
+        }
+        return -1;
+    };
+    for (int k = 0; k < 3; k++) {
+        attributes.points[k] = find(point_names[k]);
+        attributes.normals[k] = find(normal_names[k]);
+    }
+    attributes.colors = find("rgb");
+    if (attributes.colors < 0) {
+        attributes.colors = find("rgba");
+    }
+    if (attributes.colors >= 0 &&
+        header.fields[attributes.colors].size != 4) {
+        utility::LogWarning("Read PCD: ignoring rgb field of size {:d}.",
+                            header.fields[attributes.colors].size);
+        attributes.colors = -1;
+    }
+    return attributes;
+}
+
+/// Decodes the attributes of binary data, with the columns of field f at
+/// \p field_data[f], \p field_stride[f] bytes apart.
+void DecodePCDFields(const PCDHeader &header,
+                     const PCDAttributeFields &attributes,
+                     const std::vector<const char *> &field_data,
+                     const std::vector<size_t> &field_stride,
+                     geometry::PointCloud &pointcloud) {
+    auto column = [&](int f) {
+        return PCDColumn{&header.fields[f], field_data[f], field_stride[f]};
+    };
+    const PCDColumn point_columns[3] = {column(attributes.points[0]),
+                                        column(attributes.points[1]),
+                                        column(attributes.points[2])};
+    DecodePCDVector3(point_columns, header.points, pointcloud.points_);
+    if (attributes.normals[0] >= 0 && attributes.normals[1] >= 0 &&
+        attributes.normals[2] >= 0) {
+        const PCDColumn normal_columns[3] = {column(attributes.normals[0]),
+                                             column(attributes.normals[1]),
+                                             column(attributes.normals[2])};
+        DecodePCDVector3(normal_columns, header.points, pointcloud.normals_);
+    }
+    if (attributes.colors >= 0) {
+        DecodePCDColors(column(attributes.colors), header.points,
+                        pointcloud.colors_);
+    }
+}
+
+/// Parses a packed color: integers are the packed value, as written by PCL,
+/// other numbers are the bits of a float.
+bool ParsePCDPackedColor(const char *&p, const char *end, uint32_t &rgb) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    const char *begin = p;
+    double value;
+    if (!column_text::ParseDouble(p, end, value)) {
+        return false;
+    }
+    const bool is_integer = std::all_of(begin, p, [](char c) {
+        return (c >= '0' && c <= '9') || c == '+' || c == '-';
+    });
+    if (is_integer && value >= 0 && value < 4294967296.0) {
+        rgb = static_cast<uint32_t>(value);
+    } else {
+        const float bits = static_cast<float>(value);
+        std::memcpy(&rgb, &bits, sizeof(rgb));
+    }
+    return true;
+}
+
+bool ReadPCDASCII(const char *data,
+                  size_t size,
+                  const PCDHeader &header,
+                  const PCDAttributeFields &attributes,
+                  geometry::PointCloud &pointcloud) {
+    // Target of every field: 0-2 points, 3-5 normals, 6 colors, -1 none.
+    std::vector<int> targets(header.fields.size(), -1);
+    for (int k = 0; k < 3; k++) {
+        targets[attributes.points[k]] = k;
+    }
+    const bool has_normals = attributes.normals[0] >= 0 &&
+                             attributes.normals[1] >= 0 &&
+                             attributes.normals[2] >= 0;
+    if (has_normals) {
+        for (int k = 0; k < 3; k++) {
+            targets[attributes.normals[k]] = 3 + k;
+        }
+    }
+    if (attributes.colors >= 0) {
+        targets[attributes.colors] = 6;
+    }
+
+    // One point per non blank line. POINTS comes from the file, so the
+    // reservation is bounded by the lines left: a point takes at least a
+    // digit and a line break.
+    std::vector<size_t> line_begins;
+    line_begins.reserve(static_cast<size_t>(std::min<int64_t>(
+            header.points, (size - header.data_offset + 1) / 2)));
+    size_t pos = header.data_offset;
+    while (pos < size && static_cast<int64_t>(line_begins.size()) <
+                                 header.points) {
+        const char *line_end = static_cast<const char *>(
+                std::memchr(data + pos, '\n', size - pos));
+        const size_t end = line_end ? line_end - data : size;
+        if (std::any_of(data + pos, data + end, [](char c) {
+                return c != ' ' && c != '\t' && c != '\r';
+            })) {
+            line_begins.push_back(pos);
+        }
+        pos = end + 1;
+    }
+    const int64_t n = static_cast<int64_t>(line_begins.size());
+    if (n < header.points) {
+        utility::LogWarning("Read PCD: expected {:d} points, found {:d}.",
+                            header.points, n);
+    }
+
+    pointcloud.points_.resize(n);
+    if (has_normals) {
+        pointcloud.normals_.resize(n);
+    }
+    if (attributes.colors >= 0) {
+        pointcloud.colors_.resize(n);
+    }
+    bool failed = false;
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+    for (int64_t i = 0; i < n; i++) {
+        const char *p = data + line_begins[i];
+        const char *end = data + (i + 1 < n ? line_begins[i + 1] : size);
+        bool ok = true;
+        for (size_t f = 0; f < header.fields.size() && ok; f++) {
+            for (int e = 0; e < header.fields[f].count && ok; e++) {
+                const int target = e == 0 ? targets[f] : -1;
+                double value = 0.0;
+                if (target == 6) {
+                    uint32_t rgb = 0;
+                    ok = ParsePCDPackedColor(p, end, rgb);
+                    pointcloud.colors_[i] = UnpackPCDColor(rgb);
+                } else {
+                    ok = column_text::ParseDouble(p, end, value);
+                    if (target >= 3) {
+                        pointcloud.normals_[i](target - 3) = value;
+                    } else if (target >= 0) {
+                        pointcloud.points_[i](target) = value;
+                    }
+                }
+            }
+        }
+        if (!ok) {
+#pragma omp atomic write
+            failed = true;
+        }
+    }
+    if (failed) {
+        utility::LogWarning("Read PCD failed: malformed ascii data.");
+        return false;
+    }
+    return true;
+}
+
+/// Reads the point cloud from the PCD file in \p data.
+bool ReadPCD(const char *data,
+             size_t size,
+             geometry::PointCloud &pointcloud,
+             const ReadPointCloudOption &params) {
+    utility::CountingProgressReporter reporter(params.update_progress);
+    PCDHeader header;
+    if (!ParsePCDHeader(data, size, header)) {
+        utility::LogWarning("Read PCD failed: unable to parse header.");
+        return false;
+    }
+    const PCDAttributeFields attributes = FindPCDAttributeFields(header);
+    if (attributes.points[0] < 0 || attributes.points[1] < 0 ||
+        attributes.points[2] < 0) {
+        utility::LogWarning("Read PCD failed: no x, y and z fields.");
+        return false;
+    }
+    reporter.SetTotal(header.points);
+    pointcloud.Clear();
+
+    const size_t n_fields = header.fields.size();
+    std::vector<const char *> field_data(n_fields);
+    std::vector<size_t> field_stride(n_fields);
+    if (header.data_type == PCDDataType::ASCII) {
+        if (!ReadPCDASCII(data, size, header, attributes, pointcloud)) {
+            return false;
+        }
+    } else if (header.data_type == PCDDataType::Binary) {
+        // POINTS comes from the file, it is bounded before the data size
+        // is computed so that the product cannot overflow.
+        if (header.point_size == 0 || header.point_size > size ||
+            static_cast<uint64_t>(header.points) >
+                    (size - header.data_offset) / header.point_size) {
+            utility::LogWarning("Read PCD failed: truncated binary data.");
+            return false;
+        }
+        // Records are decoded in place, without an intermediate copy.
+        for (size_t f = 0; f < n_fields; f++) {
+            field_data[f] = data + header.data_offset + header.fields[f].offset;
+            field_stride[f] = header.point_size;
+        }
+        DecodePCDFields(header, attributes, field_data, field_stride,
+                        pointcloud);
+    } else {
+        uint32_t sizes[2];
+        if (header.data_offset + sizeof(sizes) > size) {
+            utility::LogWarning("Read PCD failed: truncated compressed data.");
+            return false;
+        }
+        std::memcpy(sizes, data + header.data_offset, sizeof(sizes));
+        const size_t compressed_size = sizes[0];
+        const char *compressed = data + header.data_offset + sizeof(sizes);
+        // The uncompressed size is stored in 32 bits, which bounds POINTS
+        // before the data size is computed.
+        if (header.point_size == 0 ||
+            static_cast<uint64_t>(header.points) >
+                    UINT32_MAX / header.point_size) {
+            utility::LogWarning("Read PCD failed: corrupted compressed data.");
+            return false;
+        }
+        const size_t data_size = header.points * header.point_size;
+        if (sizes[1] != data_size ||
+            compressed_size > size - header.data_offset - sizeof(sizes)) {
+            utility::LogWarning("Read PCD failed: corrupted compressed data.");
+            return false;
+        }
+        std::unique_ptr<char[]> buffer(new char[std::max<size_t>(
+                data_size, 1)]);
+        if (data_size > 0 &&
+            utility::LzfDecompress(compressed, compressed_size, buffer.get(),
+                                   data_size) != data_size) {
+            utility::LogWarning("Read PCD failed: corrupted compressed data.");
+            return false;
+        }
+        // The decompressed data stores each field for all points in turn.
+        for (size_t f = 0; f < n_fields; f++) {
+            field_data[f] =
+                    buffer.get() + header.points * header.fields[f].offset;
+            field_stride[f] =
+                    size_t(header.fields[f].size) * header.fields[f].count;
+        }
+        DecodePCDFields(header, attributes, field_data, field_stride,
+                        pointcloud);
+    }
+    reporter.Finish();
+    return true;
+}
+
+/// Writes the point cloud as PCD, with single precision fields, and passes
+/// the data, in order, to \p write, which returns false on failure.
+bool WritePCD(const geometry::PointCloud &pointcloud,
+              const WritePointCloudOption &params,
+              const std::function<bool(const char *, size_t)> &write) {
+    utility::CountingProgressReporter reporter(params.update_progress);
+    const int64_t n = static_cast<int64_t>(pointcloud.points_.size());
+    reporter.SetTotal(n);
+    const bool has_normals = pointcloud.HasNormals();
+    const bool has_colors = pointcloud.HasColors();
+    const bool ascii =
+            params.write_ascii == WritePointCloudOption::IsAscii::Ascii;
+    const bool compressed =
+            !ascii && params.compressed ==
+                              WritePointCloudOption::Compressed::Compressed;
+
+    // Fields x y z [normal_x normal_y normal_z] [rgb], 4 bytes each.
+    const int n_fields = 3 + (has_normals ? 3 : 0) + (has_colors ? 1 : 0);
+    std::string fields = "x y z", sizes, types, counts;
+    if (has_normals) {
+        fields += " normal_x normal_y normal_z";
+    }
+    if (has_colors) {
+        fields += " rgb";
+    }
+    for (int f = 0; f < n_fields; f++) {
+        sizes += f > 0 ? " 4" : "4";
+        types += f > 0 ? " F" : "F";
+        counts += f > 0 ? " 1" : "1";
+    }
+    const std::string header =
+            "# .PCD v0.7 - Point Cloud Data file format\nVERSION 0.7\n"
+            "FIELDS " + fields + "\nSIZE " + sizes + "\nTYPE " + types +
+            "\nCOUNT " + counts + "\nWIDTH " + std::to_string(n) +
+            "\nHEIGHT 1\nVIEWPOINT 0 0 0 1 0 0 0\nPOINTS " +
+            std::to_string(n) + "\nDATA " +
+            (ascii ? "ascii" : compressed ? "binary_compressed" : "binary") +
+            "\n";
+    if (!write(header.data(), header.size())) {
+        return false;
+    }
+
+    // Value of field f of point i.
+    auto get_float = [&](int64_t i, int f) -> float {
+        if (f < 3) {
+            return static_cast<float>(pointcloud.points_[i](f));
+        }
+        return static_cast<float>(pointcloud.normals_[i](f - 3));
+    };
+    const int color_field = has_colors ? n_fields - 1 : -1;
+
+    if (ascii) {
+        constexpr int64_t kBlockSize = 1 << 15;
+        const int n_blocks_max = utility::EstimateMaxThreads();
+        std::vector<std::vector<char>> block_texts(n_blocks_max);
+        std::vector<size_t> block_sizes(n_blocks_max);
+        for (int64_t batch_begin = 0; batch_begin < n;
+             batch_begin += kBlockSize * n_blocks_max) {
+            const int n_blocks = static_cast<int>(std::min<int64_t>(
+                    n_blocks_max,
+                    (n - batch_begin + kBlockSize - 1) / kBlockSize));
+#pragma omp parallel for schedule(static, 1) num_threads(n_blocks_max)
+            for (int b = 0; b < n_blocks; b++) {
+                const int64_t begin = batch_begin + b * kBlockSize;
+                const int64_t end = std::min(begin + kBlockSize, n);
+                // A float, a separator and the line break take < 20 bytes.
+                std::vector<char> &text = block_texts[b];
+                text.resize((end - begin) * n_fields * 20);
+                char *p = text.data();
+                char *last = text.data() + text.size();
+                for (int64_t i = begin; i < end; i++) {
+                    for (int f = 0; f < n_fields; f++) {
+                        if (f > 0) {
+                            *p++ = ' ';
+                        }
+                        p = f == color_field
+                                    ? std::to_chars(
+                                              p, last,
+                                              PackPCDColor(
+                                                      pointcloud.colors_[i]))
+                                              .ptr
+                                    : std::to_chars(p, last, get_float(i, f))
+                                              .ptr;
+                    }
+                    *p++ = '\n';
+                }
+                block_sizes[b] = p - text.data();
+            }
+            for (int b = 0; b < n_blocks; b++) {
+                if (!write(block_texts[b].data(), block_sizes[b])) {
+                    return false;
+                }
+            }
+            reporter.Update(
+                    std::min(batch_begin + kBlockSize * n_blocks_max, n));
+        }
+    } else if (!compressed) {
+        const size_t point_size = 4 * n_fields;
+        constexpr int64_t kBatchSize = 1 << 18;
+        std::vector<char> records(std::min<int64_t>(n, kBatchSize) *
+                                  point_size);
+        for (int64_t batch_begin = 0; batch_begin < n;
+             batch_begin += kBatchSize) {
+            const int64_t batch_end = std::min(batch_begin + kBatchSize, n);
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+            for (int64_t i = batch_begin; i < batch_end; i++) {
+                char *record = records.data() + (i - batch_begin) * point_size;
+                for (int f = 0; f < n_fields; f++) {
+                    if (f == color_field) {
+                        const uint32_t rgb =
+                                PackPCDColor(pointcloud.colors_[i]);
+                        std::memcpy(record + 4 * f, &rgb, 4);
+                    } else {
+                        const float value = get_float(i, f);
+                        std::memcpy(record + 4 * f, &value, 4);
+                    }
+                }
+            }
+            if (!write(records.data(),
+                       (batch_end - batch_begin) * point_size)) {
+                return false;
+            }
+            reporter.Update(batch_end);
+        }
+    } else {
+        // Each field is stored for all points in turn, then compressed.
+        const size_t data_size = size_t(n) * 4 * n_fields;
+        if (data_size > UINT32_MAX) {
+            utility::LogWarning(
+                    "Write PCD failed: too many points for binary_compressed.");
+            return false;
+        }
+        std::unique_ptr<char[]> columns(
+                new char[std::max<size_t>(data_size, 1)]);
+        for (int f = 0; f < n_fields; f++) {
+            char *column = columns.get() + size_t(n) * 4 * f;
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+            for (int64_t i = 0; i < n; i++) {
+                if (f == color_field) {
+                    const uint32_t rgb = PackPCDColor(pointcloud.colors_[i]);
+                    std::memcpy(column + 4 * i, &rgb, 4);
+                } else {
+                    const float value = get_float(i, f);
+                    std::memcpy(column + 4 * i, &value, 4);
+                }
+            }
+        }
+        const size_t max_size = utility::LzfMaxCompressedSize(data_size);
+        std::unique_ptr<char[]> compressed_data(new char[8 + max_size]);
+        const uint32_t compressed_size = static_cast<uint32_t>(
+                utility::LzfCompress(columns.get(), data_size,
+                                     compressed_data.get() + 8, max_size));
+        if (compressed_size == 0 && data_size > 0) {
+            utility::LogWarning("Write PCD failed: unable to compress data.");
+            return false;
+        }
+        const uint32_t uncompressed_size = static_cast<uint32_t>(data_size);
+        std::memcpy(compressed_data.get(), &compressed_size, 4);
+        std::memcpy(compressed_data.get() + 4, &uncompressed_size, 4);
+        if (!write(compressed_data.get(), 8 + compressed_size)) {
+            return false;
+        }
+    }
+    reporter.Finish();
+    return true;
+}
+
+}  // unnamed namespace
+/// @endcond
+
+FileGeometry ReadFileGeometryTypePCD(const std::string &path) {
+    return CONTAINS_POINTS;
+}
+
+bool ReadPointCloudFromPCD(const std::string &filename,
+                           geometry::PointCloud &pointcloud,
+                           const ReadPointCloudOption &params) {
+    try {
+        utility::filesystem::MappedFile file;
+        if (!file.Open(filename)) {
+            utility::LogWarning("Read PCD failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        return ReadPCD(file.GetData(), file.GetSize(), pointcloud, params);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read PCD failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool ReadPointCloudInMemoryFromPCD(const unsigned char *buffer,
+                                   const size_t length,
+                                   geometry::PointCloud &pointcloud,
+                                   const ReadPointCloudOption &params) {
+    try {
+        return ReadPCD(reinterpret_cast<const char *>(buffer), length,
+                       pointcloud, params);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read PCD failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool WritePointCloudToPCD(const std::string &filename,
+                          const geometry::PointCloud &pointcloud,
+                          const WritePointCloudOption &params) {
+    try {
+        utility::filesystem::CFile file;
+        if (!file.Open(filename, "wb")) {
+            utility::LogWarning("Write PCD failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        return WritePCD(pointcloud, params,
+                        [&](const char *data, size_t size) {
+                            if (fwrite(data, 1, size, file.GetFILE()) != size) {
+                                utility::LogWarning(
+                                        "Write PCD failed: unable to write "
+                                        "file: {}",
+                                        filename);
+                                return false;
+                            }
+                            return true;
+                        });
+    } catch (const std::exception &e) {
+        utility::LogWarning("Write PCD failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool WritePointCloudInMemoryToPCD(unsigned char *&buffer,
+                                  size_t &length,
+                                  const geometry::PointCloud &pointcloud,
+                                  const WritePointCloudOption &params) {
+    try {
+        std::vector<char> content;
+        if (!WritePCD(pointcloud, params, [&](const char *data, size_t size) {
+                content.insert(content.end(), data, data + size);
+                return true;
+            })) {
+            return false;
+        }
+        length = content.size();
+        buffer = new unsigned char[length];  // we do this for the caller
+        std::memcpy(buffer, content.data(), length);
+        return true;
+    } catch (const std::exception &e) {
+        utility::LogWarning("Write PCD failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+}  // namespace io
+}  // namespace tiny3d
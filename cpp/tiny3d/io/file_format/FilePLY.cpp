@@ -7,11 +7,20 @@
 
 #include <rply.h>
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
 #include "tiny3d/io/FileFormatIO.h"
 #include "tiny3d/geometry/VoxelGrid.h"
 #include "tiny3d/io/PointCloudIO.h"
+#include "tiny3d/io/PointCloudReader.h"
 #include "tiny3d/io/TriangleMeshIO.h"
+#include "tiny3d/io/file_format/ColumnTextIO.h"
+#include "tiny3d/utility/FileSystem.h"
 #include "tiny3d/utility/Logging.h"
+#include "tiny3d/utility/Parallel.h"
 #include "tiny3d/utility/ProgressBar.h"
 #include "tiny3d/utility/ProgressReporters.h"
 
@@ -22,6 +31,13 @@ namespace io {
 /// @cond
 namespace {
 
+bool IsLittleEndianHost() {
+    const uint16_t one = 1;
+    uint8_t first_byte;
+    std::memcpy(&first_byte, &one, 1);
+    return first_byte == 1;
+}
+
 namespace ply_pointcloud_reader {
 
 struct PLYReaderState {
@@ -90,6 +106,729 @@ int ReadColorCallback(p_ply_argument argument) {
 
 }  // namespace ply_pointcloud_reader
 
+/// Reads binary little endian PLY point clouds directly from a memory mapping
+/// of the file, bypassing the per scalar callbacks of rply. Files with other
+/// layouts are left to rply.
+namespace ply_pointcloud_fast_reader {
+
+enum class PLYScalarType {
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64,
+};
+
+struct PLYProperty {
+    std::string name;
+    PLYScalarType type;
+    bool is_list;
+    /// Byte offset in the record of its element.
+    size_t offset;
+};
+
+struct PLYElement {
+    std::string name;
+    int64_t count;
+    std::vector<PLYProperty> properties;
+    /// Size of a record in bytes, 0 if the records have variable size.
+    size_t record_size;
+};
+
+struct PLYHeader {
+    std::string format;
+    std::vector<PLYElement> elements;
+    /// Byte offset of the data following the header.
+    size_t data_offset;
+};
+
+bool ParsePLYScalarType(const std::string &name, PLYScalarType &type) {
+    static const std::pair<const char *, PLYScalarType> types[] = {
+            {"char", PLYScalarType::Int8},      {"int8", PLYScalarType::Int8},
+            {"uchar", PLYScalarType::UInt8},    {"uint8", PLYScalarType::UInt8},
+            {"short", PLYScalarType::Int16},    {"int16", PLYScalarType::Int16},
+            {"ushort", PLYScalarType::UInt16},  {"uint16", PLYScalarType::UInt16},
+            {"int", PLYScalarType::Int32},      {"int32", PLYScalarType::Int32},
+            {"uint", PLYScalarType::UInt32},    {"uint32", PLYScalarType::UInt32},
+            {"float", PLYScalarType::Float32},  {"float32", PLYScalarType::Float32},
+            {"double", PLYScalarType::Float64}, {"float64", PLYScalarType::Float64},
+    };
+    for (const auto &t : types) {
+        if (name == t.first) {
+            type = t.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t PLYScalarSize(PLYScalarType type) {
+    switch (type) {
+        case PLYScalarType::Int8:
+        case PLYScalarType::UInt8:
+            return 1;
+        case PLYScalarType::Int16:
+        case PLYScalarType::UInt16:
+            return 2;
+        case PLYScalarType::Int32:
+        case PLYScalarType::UInt32:
+        case PLYScalarType::Float32:
+            return 4;
+        case PLYScalarType::Float64:
+            return 8;
+    }
+    return 0;
+}
+
+/// Parses the header at the beginning of \p data. Returns false if it is not
+/// a well formed PLY header.
+bool ParsePLYHeader(const char *data, size_t size, PLYHeader &header) {
+    header = PLYHeader();
+    size_t pos = 0;
+    bool first_line = true;
+    while (pos < size) {
+        const char *line_end = static_cast<const char *>(
+                std::memchr(data + pos, '\n', size - pos));
+        if (line_end == nullptr) {
+            return false;
+        }
+        std::string line(data + pos, line_end);
+        pos = line_end - data + 1;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::istringstream tokens(line);
+        std::string keyword;
+        tokens >> keyword;
+        if (first_line) {
+            if (keyword != "ply") {
+                return false;
+            }
+            first_line = false;
+        } else if (keyword == "format") {
+            tokens >> header.format;
+        } else if (keyword == "element") {
+            PLYElement element;
+            if (!(tokens >> element.name >> element.count) ||
+                element.count < 0) {
+                return false;
+            }
+            element.record_size = 0;
+            header.elements.push_back(element);
+        } else if (keyword == "property") {
+            if (header.elements.empty()) {
+                return false;
+            }
+            PLYElement &element = header.elements.back();
+            PLYProperty property;
+            std::string type;
+            tokens >> type;
+            property.is_list = type == "list";
+            if (property.is_list) {
+                std::string count_type;
+                tokens >> count_type >> type;
+            }
+            if (!(tokens >> property.name) ||
+                !ParsePLYScalarType(type, property.type)) {
+                return false;
+            }
+            property.offset = element.properties.empty()
+                                      ? 0
+                                      : element.properties.back().offset +
+                                                PLYScalarSize(element.properties
+                                                                      .back()
+                                                                      .type);
+            element.properties.push_back(property);
+        } else if (keyword == "end_header") {
+            header.data_offset = pos;
+            for (PLYElement &element : header.elements) {
+                bool fixed_size = true;
+                for (const PLYProperty &property : element.properties) {
+                    fixed_size = fixed_size && !property.is_list;
+                }
+                element.record_size =
+                        fixed_size && !element.properties.empty()
+                                ? element.properties.back().offset +
+                                          PLYScalarSize(element.properties
+                                                                .back()
+                                                                .type)
+                                : 0;
+            }
+            return true;
+        }
+        // Comments and obj_info lines are ignored.
+    }
+    return false;
+}
+
+/// Converts the scalars of one property of \p count records, \p stride bytes
+/// apart, into every third double of \p out, divided by \p divisor.
+template <typename T>
+void DecodePLYProperty(const char *records,
+                       size_t stride,
+                       int64_t count,
+                       double divisor,
+                       double *out) {
+    if (divisor == 1.0) {
+        for (int64_t i = 0; i < count; i++) {
+            T value;
+            std::memcpy(&value, records + i * stride, sizeof(T));
+            out[3 * i] = static_cast<double>(value);
+        }
+    } else {
+        for (int64_t i = 0; i < count; i++) {
+            T value;
+            std::memcpy(&value, records + i * stride, sizeof(T));
+            out[3 * i] = static_cast<double>(value) / divisor;
+        }
+    }
+}
+
+void DecodePLYProperty(PLYScalarType type,
+                       const char *records,
+                       size_t stride,
+                       int64_t count,
+                       double divisor,
+                       double *out) {
+    switch (type) {
+        case PLYScalarType::Int8:
+            DecodePLYProperty<int8_t>(records, stride, count, divisor, out);
+            break;
+        case PLYScalarType::UInt8:
+            DecodePLYProperty<uint8_t>(records, stride, count, divisor, out);
+            break;
+        case PLYScalarType::Int16:
+            DecodePLYProperty<int16_t>(records, stride, count, divisor, out);
+            break;
+        case PLYScalarType::UInt16:
+            DecodePLYProperty<uint16_t>(records, stride, count, divisor, out);
+            break;
+        case PLYScalarType::Int32:
+            DecodePLYProperty<int32_t>(records, stride, count, divisor, out);
+            break;
+        case PLYScalarType::UInt32:
+            DecodePLYProperty<uint32_t>(records, stride, count, divisor, out);
+            break;
+        case PLYScalarType::Float32:
+            DecodePLYProperty<float>(records, stride, count, divisor, out);
+            break;
+        case PLYScalarType::Float64:
+            DecodePLYProperty<double>(records, stride, count, divisor, out);
+            break;
+    }
+}
+
+/// Finds the properties \p names of \p element. Returns false unless either
+/// all or none of them exist.
+bool FindPLYProperties(const PLYElement &element,
+                       const char *const names[3],
+                       const PLYProperty *properties[3]) {
+    int found = 0;
+    for (int c = 0; c < 3; c++) {
+        properties[c] = nullptr;
+        for (const PLYProperty &property : element.properties) {
+            if (property.name == names[c]) {
+                properties[c] = &property;
+                found++;
+                break;
+            }
+        }
+    }
+    return found == 0 || found == 3;
+}
+
+/// Location and properties of the vertex records of a binary PLY file.
+struct PLYVertexLayout {
+    /// Byte offset of the first record.
+    size_t offset;
+    size_t stride;
+    int64_t count;
+    /// The properties of the coordinates, normals and colors, or nullptr.
+    const PLYProperty *point_properties[3];
+    const PLYProperty *normal_properties[3];
+    const PLYProperty *color_properties[3];
+};
+
+/// Finds the vertex records of the binary PLY file of \p header, of
+/// \p file_size bytes. Returns false if they cannot be located or decoded
+/// directly.
+bool FindPLYVertexLayout(const PLYHeader &header,
+                         size_t file_size,
+                         PLYVertexLayout &layout) {
+    // Returns whether the \p count records of \p record_size bytes at
+    // \p offset fit in the file. Counts come from the header, the products
+    // must not overflow.
+    auto fits = [file_size](size_t offset, size_t record_size, int64_t count) {
+        return offset <= file_size &&
+               static_cast<uint64_t>(count) <=
+                       (file_size - offset) / record_size;
+    };
+    // Elements preceding the vertices must have fixed size records to
+    // locate the vertex data.
+    size_t vertex_offset = header.data_offset;
+    const PLYElement *vertex = nullptr;
+    for (const PLYElement &element : header.elements) {
+        if (element.name == "vertex") {
+            vertex = &element;
+            break;
+        }
+        if (element.count == 0) {
+            continue;
+        }
+        if (element.record_size == 0 ||
+            !fits(vertex_offset, element.record_size, element.count)) {
+            return false;
+        }
+        vertex_offset += element.record_size * element.count;
+    }
+    if (vertex == nullptr || vertex->record_size == 0 ||
+        !fits(vertex_offset, vertex->record_size, vertex->count)) {
+        return false;
+    }
+    static const char *const point_names[3] = {"x", "y", "z"};
+    static const char *const normal_names[3] = {"nx", "ny", "nz"};
+    static const char *const color_names[3] = {"red", "green", "blue"};
+    if (!FindPLYProperties(*vertex, point_names, layout.point_properties) ||
+        !FindPLYProperties(*vertex, normal_names, layout.normal_properties) ||
+        !FindPLYProperties(*vertex, color_names, layout.color_properties) ||
+        layout.point_properties[0] == nullptr) {
+        return false;
+    }
+    layout.offset = vertex_offset;
+    layout.stride = vertex->record_size;
+    layout.count = vertex->count;
+    return true;
+}
+
+/// Decodes the \p n_points records at \p records into \p pointcloud, whose
+/// attributes are resized. Records are decoded in chunks that stay in cache,
+/// one property at a time, and in parallel over the chunks. Progress is
+/// reported between batches of chunks.
+void DecodePLYVertices(const char *records,
+                       const PLYVertexLayout &layout,
+                       int64_t n_points,
+                       geometry::PointCloud &pointcloud,
+                       utility::CountingProgressReporter &reporter) {
+    const bool has_normals = layout.normal_properties[0] != nullptr;
+    const bool has_colors = layout.color_properties[0] != nullptr;
+    const size_t stride = layout.stride;
+    pointcloud.Clear();
+    pointcloud.points_.resize(n_points);
+    pointcloud.normals_.resize(has_normals ? n_points : 0);
+    pointcloud.colors_.resize(has_colors ? n_points : 0);
+
+    constexpr int64_t kChunkSize = 1 << 14;
+    constexpr int64_t kBatchSize = kChunkSize * 256;
+    for (int64_t batch_begin = 0; batch_begin < n_points;
+         batch_begin += kBatchSize) {
+        const int64_t batch_end = std::min(batch_begin + kBatchSize, n_points);
+        const int64_t n_chunks =
+                (batch_end - batch_begin + kChunkSize - 1) / kChunkSize;
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+        for (int64_t chunk = 0; chunk < n_chunks; chunk++) {
+            const int64_t begin = batch_begin + chunk * kChunkSize;
+            const int64_t count = std::min(kChunkSize, batch_end - begin);
+            const char *chunk_records = records + begin * stride;
+            for (int c = 0; c < 3; c++) {
+                const PLYProperty *point = layout.point_properties[c];
+                DecodePLYProperty(point->type, chunk_records + point->offset,
+                                  stride, count, 1.0,
+                                  pointcloud.points_[begin].data() + c);
+                if (has_normals) {
+                    const PLYProperty *normal = layout.normal_properties[c];
+                    DecodePLYProperty(normal->type,
+                                      chunk_records + normal->offset, stride,
+                                      count, 1.0,
+                                      pointcloud.normals_[begin].data() + c);
+                }
+                if (has_colors) {
+                    const PLYProperty *color = layout.color_properties[c];
+                    DecodePLYProperty(color->type,
+                                      chunk_records + color->offset, stride,
+                                      count, 255.0,
+                                      pointcloud.colors_[begin].data() + c);
+                }
+            }
+        }
+        reporter.Update(batch_end);
+    }
+}
+
+/// Reads the point cloud with the fast path. Returns false without modifying
+/// \p pointcloud if the file is not supported by it.
+bool ReadPointCloud(const std::string &filename,
+                    geometry::PointCloud &pointcloud,
+                    const ReadPointCloudOption &params) {
+    utility::filesystem::MappedFile file;
+    if (!IsLittleEndianHost() || !file.Open(filename)) {
+        return false;
+    }
+    PLYHeader header;
+    PLYVertexLayout layout;
+    if (!ParsePLYHeader(file.GetData(), file.GetSize(), header) ||
+        header.format != "binary_little_endian" ||
+        !FindPLYVertexLayout(header, file.GetSize(), layout) ||
+        layout.count <= 0) {
+        return false;
+    }
+    utility::CountingProgressReporter reporter(params.update_progress);
+    reporter.SetTotal(layout.count);
+    DecodePLYVertices(file.GetData() + layout.offset, layout, layout.count,
+                      pointcloud, reporter);
+    reporter.Finish();
+    return true;
+}
+
+}  // namespace ply_pointcloud_fast_reader
+
+/// Reads the vertices of PLY point clouds in chunks from a memory mapping of
+/// the file: binary little endian records are decoded like by the fast
+/// reader, ASCII records are parsed in parallel, one line per vertex.
+namespace ply_pointcloud_chunk_reader {
+using namespace ply_pointcloud_fast_reader;
+
+class PLYPointCloudReader : public PointCloudReader {
+public:
+    bool Open(const std::string &filename) {
+        if (!file_.Open(filename)) {
+            utility::LogWarning("Read PLY failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        if (!ParsePLYHeader(file_.GetData(), file_.GetSize(), header_)) {
+            utility::LogWarning("Read PLY failed: unable to parse header.");
+            return false;
+        }
+        ascii_ = header_.format == "ascii";
+        if (ascii_ ? !FindASCIIVertices()
+                   : header_.format != "binary_little_endian" ||
+                             !IsLittleEndianHost() ||
+                             !FindPLYVertexLayout(header_, file_.GetSize(),
+                                                  layout_)) {
+            utility::LogWarning(
+                    "Read PLY failed: the vertices of {} cannot be read in "
+                    "chunks, only ascii and binary little endian vertices "
+                    "without list properties are supported.",
+                    filename);
+            return false;
+        }
+        return true;
+    }
+
+    int64_t GetPointCount() override { return layout_.count; }
+
+    bool Seek(int64_t index) override {
+        if (index < 0 || index > layout_.count) {
+            utility::LogWarning("Read PLY failed: point {:d} out of range.",
+                                index);
+            return false;
+        }
+        if (ascii_) {
+            if (line_index_.empty() && !BuildLineIndex()) {
+                return false;
+            }
+            const char *line =
+                    file_.GetData() + line_index_[index >> kIndexShift];
+            for (int64_t i = index & ((1 << kIndexShift) - 1); i > 0; i--) {
+                line = NextLine(line);
+            }
+            offset_ = line - file_.GetData();
+        }
+        position_ = index;
+        return true;
+    }
+
+    bool ReadChunk(int64_t max_points, geometry::PointCloud &chunk) override {
+        chunk.Clear();
+        const int64_t n_points =
+                std::min(max_points, layout_.count - position_);
+        if (n_points <= 0) {
+            return false;
+        }
+        if (ascii_) {
+            return ReadASCIIChunk(n_points, chunk);
+        }
+        utility::CountingProgressReporter reporter(nullptr);
+        DecodePLYVertices(
+                file_.GetData() + layout_.offset + position_ * layout_.stride,
+                layout_, n_points, chunk, reporter);
+        position_ += n_points;
+        return true;
+    }
+
+private:
+    /// Lines of ASCII vertices are indexed every 2^kIndexShift vertices.
+    static constexpr int kIndexShift = 16;
+
+    /// Returns the beginning of the line following \p line, or the end of the
+    /// file.
+    const char *NextLine(const char *line) const {
+        const char *end = file_.GetData() + file_.GetSize();
+        const char *line_end = static_cast<const char *>(
+                std::memchr(line, '\n', end - line));
+        return line_end == nullptr ? end : line_end + 1;
+    }
+
+    /// Locates the first vertex line and the columns of the vertex properties.
+    bool FindASCIIVertices() {
+        // Every record is a line, the vertex lines follow the lines of the
+        // preceding elements.
+        int64_t preceding_lines = 0;
+        const PLYElement *vertex = nullptr;
+        for (const PLYElement &element : header_.elements) {
+            if (element.name == "vertex") {
+                vertex = &element;
+                break;
+            }
+            preceding_lines += element.count;
+        }
+        if (vertex == nullptr || vertex->record_size == 0) {
+            return false;
+        }
+        static const char *const point_names[3] = {"x", "y", "z"};
+        static const char *const normal_names[3] = {"nx", "ny", "nz"};
+        static const char *const color_names[3] = {"red", "green", "blue"};
+        if (!FindPLYProperties(*vertex, point_names,
+                               layout_.point_properties) ||
+            !FindPLYProperties(*vertex, normal_names,
+                               layout_.normal_properties) ||
+            !FindPLYProperties(*vertex, color_names,
+                               layout_.color_properties) ||
+            layout_.point_properties[0] == nullptr) {
+            return false;
+        }
+        // Values are parsed up to the last needed column.
+        auto column = [vertex](const PLYProperty *property) {
+            return property == nullptr
+                           ? -1
+                           : static_cast<int>(property -
+                                              vertex->properties.data());
+        };
+        num_columns_ = 0;
+        for (int c = 0; c < 3; c++) {
+            point_columns_[c] = column(layout_.point_properties[c]);
+            normal_columns_[c] = column(layout_.normal_properties[c]);
+            color_columns_[c] = column(layout_.color_properties[c]);
+            num_columns_ = std::max({num_columns_, point_columns_[c] + 1,
+                                     normal_columns_[c] + 1,
+                                     color_columns_[c] + 1});
+        }
+        const char *line = file_.GetData() + header_.data_offset;
+        for (int64_t i = 0; i < preceding_lines; i++) {
+            line = NextLine(line);
+        }
+        layout_.offset = line - file_.GetData();
+        layout_.stride = 0;
+        layout_.count = vertex->count;
+        offset_ = layout_.offset;
+        return true;
+    }
+
+    /// Records the beginning of every 2^kIndexShift-th vertex line.
+    bool BuildLineIndex() {
+        const char *end = file_.GetData() + file_.GetSize();
+        const char *line = file_.GetData() + layout_.offset;
+        for (int64_t i = 0; i <= layout_.count; i++) {
+            if (i < layout_.count && line == end) {
+                utility::LogWarning("Read PLY failed: the file is truncated.");
+                line_index_.clear();
+                return false;
+            }
+            if ((i & ((1 << kIndexShift) - 1)) == 0) {
+                line_index_.push_back(line - file_.GetData());
+            }
+            line = NextLine(line);
+        }
+        return true;
+    }
+
+    bool ReadASCIIChunk(int64_t n_points, geometry::PointCloud &chunk) {
+        const char *end = file_.GetData() + file_.GetSize();
+        std::vector<const char *> lines(n_points + 1);
+        lines[0] = file_.GetData() + offset_;
+        for (int64_t i = 0; i < n_points; i++) {
+            if (lines[i] == end) {
+                utility::LogWarning("Read PLY failed: the file is truncated.");
+                return false;
+            }
+            lines[i + 1] = NextLine(lines[i]);
+        }
+        const bool has_normals = normal_columns_[0] >= 0;
+        const bool has_colors = color_columns_[0] >= 0;
+        chunk.points_.resize(n_points);
+        chunk.normals_.resize(has_normals ? n_points : 0);
+        chunk.colors_.resize(has_colors ? n_points : 0);
+
+        std::atomic<bool> success(true);
+#pragma omp parallel num_threads(utility::EstimateMaxThreads())
+        {
+            std::vector<double> values(num_columns_);
+#pragma omp for schedule(static)
+            for (int64_t i = 0; i < n_points; i++) {
+                const char *p = lines[i];
+                for (int c = 0; c < num_columns_; c++) {
+                    if (!column_text::ParseDouble(p, lines[i + 1],
+                                                  values[c])) {
+                        success = false;
+                        break;
+                    }
+                }
+                for (int c = 0; c < 3; c++) {
+                    chunk.points_[i](c) = values[point_columns_[c]];
+                    if (has_normals) {
+                        chunk.normals_[i](c) = values[normal_columns_[c]];
+                    }
+                    if (has_colors) {
+                        chunk.colors_[i](c) =
+                                values[color_columns_[c]] / 255.0;
+                    }
+                }
+            }
+        }
+        if (!success) {
+            utility::LogWarning("Read PLY failed: invalid vertex line.");
+            chunk.Clear();
+            return false;
+        }
+        offset_ = lines[n_points] - file_.GetData();
+        position_ += n_points;
+        return true;
+    }
+
+    utility::filesystem::MappedFile file_;
+    PLYHeader header_;
+    PLYVertexLayout layout_;
+    bool ascii_ = false;
+    /// Columns of the vertex properties of ASCII files, -1 if absent, and the
+    /// number of values to parse on every line.
+    int point_columns_[3];
+    int normal_columns_[3];
+    int color_columns_[3];
+    int num_columns_ = 0;
+    /// Byte offset of the next ASCII vertex line.
+    size_t offset_ = 0;
+    std::vector<size_t> line_index_;
+};
+
+}  // namespace ply_pointcloud_chunk_reader
+
+/// Writes binary little endian PLY point clouds by formatting the vertex
+/// records into a large buffer in parallel instead of calling rply per
+/// scalar. The output is identical to the one of rply.
+namespace ply_pointcloud_fast_writer {
+
+template <typename T>
+char *EncodeVector3(const Eigen::Vector3d &v, char *out) {
+    const T values[3] = {static_cast<T>(v(0)), static_cast<T>(v(1)),
+                         static_cast<T>(v(2))};
+    std::memcpy(out, values, sizeof(values));
+    return out + sizeof(values);
+}
+
+bool WritePointCloud(const std::string &filename,
+                     const geometry::PointCloud &pointcloud,
+                     const WritePointCloudOption &params) {
+    const bool has_normals = pointcloud.HasNormals();
+    const bool has_colors = pointcloud.HasColors();
+    const bool write_float32 = params.write_float32;
+    const char *const scalar_type = write_float32 ? "float" : "double";
+    const size_t scalar_size = write_float32 ? 4 : 8;
+    const size_t record_size = 3 * scalar_size +
+                               (has_normals ? 3 * scalar_size : 0) +
+                               (has_colors ? 3 : 0);
+    const int64_t n_points = static_cast<int64_t>(pointcloud.points_.size());
+
+    std::string header = fmt::format(
+            "ply\nformat binary_little_endian 1.0\ncomment Created by "
+            "tiny3d\nelement vertex {:d}\n",
+            n_points);
+    for (const char *name : {"x", "y", "z"}) {
+        header += fmt::format("property {} {}\n", scalar_type, name);
+    }
+    if (has_normals) {
+        for (const char *name : {"nx", "ny", "nz"}) {
+            header += fmt::format("property {} {}\n", scalar_type, name);
+        }
+    }
+    if (has_colors) {
+        for (const char *name : {"red", "green", "blue"}) {
+            header += fmt::format("property uchar {}\n", name);
+        }
+    }
+    header += "end_header\n";
+
+    utility::filesystem::CFile file;
+    if (!file.Open(filename, "wb")) {
+        utility::LogWarning("Write PLY failed: unable to open file: {}",
+                            filename);
+        return false;
+    }
+    if (fwrite(header.data(), 1, header.size(), file.GetFILE()) !=
+        header.size()) {
+        utility::LogWarning("Write PLY failed: unable to write file: {}",
+                            filename);
+        return false;
+    }
+
+    utility::CountingProgressReporter reporter(params.update_progress);
+    reporter.SetTotal(n_points);
+
+    // Batches of records are formatted in parallel and written at once.
+    constexpr int64_t kBatchSize = 1 << 18;
+    std::vector<char> buffer(
+            std::min(kBatchSize, n_points) * record_size);
+    bool color_clamped = false;
+    for (int64_t batch_begin = 0; batch_begin < n_points;
+         batch_begin += kBatchSize) {
+        const int64_t count = std::min(kBatchSize, n_points - batch_begin);
+        bool batch_color_clamped = false;
+#pragma omp parallel for schedule(static) \
+        reduction(|| : batch_color_clamped) \
+        num_threads(utility::EstimateMaxThreads())
+        for (int64_t k = 0; k < count; k++) {
+            const int64_t i = batch_begin + k;
+            char *out = buffer.data() + k * record_size;
+            out = write_float32
+                          ? EncodeVector3<float>(pointcloud.points_[i], out)
+                          : EncodeVector3<double>(pointcloud.points_[i], out);
+            if (has_normals) {
+                out = write_float32
+                              ? EncodeVector3<float>(pointcloud.normals_[i],
+                                                     out)
+                              : EncodeVector3<double>(pointcloud.normals_[i],
+                                                      out);
+            }
+            if (has_colors) {
+                const Eigen::Vector3d &color = pointcloud.colors_[i];
+                batch_color_clamped =
+                        batch_color_clamped ||
+                        (color.array() < 0).any() || (color.array() > 1).any();
+                const Eigen::Vector3uint8 rgb = utility::ColorToUint8(color);
+                std::memcpy(out, rgb.data(), 3);
+            }
+        }
+        if (batch_color_clamped && !color_clamped) {
+            utility::LogWarning("Write Ply clamped color value to valid range");
+            color_clamped = true;
+        }
+        const size_t size = count * record_size;
+        if (fwrite(buffer.data(), 1, size, file.GetFILE()) != size) {
+            utility::LogWarning("Write PLY failed: unable to write file: {}",
+                                filename);
+            return false;
+        }
+        reporter.Update(batch_begin + count);
+    }
+    reporter.Finish();
+    return true;
+}
+
+}  // namespace ply_pointcloud_fast_writer
+
 namespace ply_trianglemesh_reader {
 
 struct PLYReaderState {
@@ -302,6 +1041,11 @@ bool ReadPointCloudFromPLY(const std::string &filename,
                            const ReadPointCloudOption &params) {
     using namespace ply_pointcloud_reader;
 
+    if (ply_pointcloud_fast_reader::ReadPointCloud(filename, pointcloud,
+                                                   params)) {
+        return true;
+    }
+
     p_ply ply_file = ply_open(filename.c_str(), NULL, 0, NULL);
     if (!ply_file) {
         utility::LogWarning("Read PLY failed: unable to open file: {}",
@@ -370,6 +1114,19 @@ bool WritePointCloudToPLY(const std::string &filename,
         return false;
     }
 
+    if (!bool(params.write_ascii) && IsLittleEndianHost()) {
+        try {
+            return ply_pointcloud_fast_writer::WritePointCloud(
+                    filename, pointcloud, params);
+        } catch (const std::exception &e) {
+            utility::LogWarning("Write PLY failed with exception: {}",
+                                e.what());
+            return false;
+        }
+    }
+
+    const e_ply_type scalar_type =
+            params.write_float32 ? PLY_FLOAT : PLY_DOUBLE;
     p_ply ply_file =
             ply_create(filename.c_str(),
                        bool(params.write_ascii) ? PLY_ASCII : PLY_LITTLE_ENDIAN,
@@ -382,13 +1139,13 @@ bool WritePointCloudToPLY(const std::string &filename,
     ply_add_comment(ply_file, "Created by tiny3d");
     ply_add_element(ply_file, "vertex",
                     static_cast<long>(pointcloud.points_.size()));
-    ply_add_property(ply_file, "x", PLY_DOUBLE, PLY_DOUBLE, PLY_DOUBLE);
-    ply_add_property(ply_file, "y", PLY_DOUBLE, PLY_DOUBLE, PLY_DOUBLE);
-    ply_add_property(ply_file, "z", PLY_DOUBLE, PLY_DOUBLE, PLY_DOUBLE);
+    ply_add_property(ply_file, "x", scalar_type, scalar_type, scalar_type);
+    ply_add_property(ply_file, "y", scalar_type, scalar_type, scalar_type);
+    ply_add_property(ply_file, "z", scalar_type, scalar_type, scalar_type);
     if (pointcloud.HasNormals()) {
-        ply_add_property(ply_file, "nx", PLY_DOUBLE, PLY_DOUBLE, PLY_DOUBLE);
-        ply_add_property(ply_file, "ny", PLY_DOUBLE, PLY_DOUBLE, PLY_DOUBLE);
-        ply_add_property(ply_file, "nz", PLY_DOUBLE, PLY_DOUBLE, PLY_DOUBLE);
+        ply_add_property(ply_file, "nx", scalar_type, scalar_type, scalar_type);
+        ply_add_property(ply_file, "ny", scalar_type, scalar_type, scalar_type);
+        ply_add_property(ply_file, "nz", scalar_type, scalar_type, scalar_type);
     }
     if (pointcloud.HasColors()) {
         ply_add_property(ply_file, "red", PLY_UCHAR, PLY_UCHAR, PLY_UCHAR);
@@ -750,5 +1507,15 @@ bool WriteVoxelGridToPLY(const std::string &filename,
     return true;
 }
 
+std::unique_ptr<PointCloudReader> OpenPointCloudReaderForPLY(
+        const std::string &filename) {
+    using ply_pointcloud_chunk_reader::PLYPointCloudReader;
+    auto reader = std::make_unique<PLYPointCloudReader>();
+    if (!reader->Open(filename)) {
+        return nullptr;
+    }
+    return reader;
+}
+
 }  // namespace io
 }  // namespace tiny3d
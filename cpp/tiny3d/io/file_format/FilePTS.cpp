@@ -0,0 +1,196 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "tiny3d/io/FileFormatIO.h"
+#include "tiny3d/io/PointCloudIO.h"
+#include "tiny3d/io/file_format/ColumnTextIO.h"
+#include "tiny3d/utility/FileSystem.h"
+#include "tiny3d/utility/Logging.h"
+
+namespace tiny3d {
+namespace io {
+
+/// @cond
+namespace {
+
+/// Returns the layout of the point lines of a PTS file: x y z [i] [r g b],
+/// with colors in [0, 255], given the number of columns of the first line.
+column_text::ColumnLayout GetPTSLayout(int num_columns) {
+    column_text::ColumnLayout layout;
+    layout.color_uint8 = true;
+    if (num_columns >= 7) {
+        layout.num_columns = 7;
+        layout.color_column = 4;
+    } else if (num_columns == 6) {
+        layout.num_columns = 6;
+        layout.color_column = 3;
+    } else if (num_columns >= 4) {
+        layout.num_columns = 4;
+    } else {
+        layout.num_columns = 3;
+    }
+    return layout;
+}
+
+/// Parses PTS text: an optional header line with the number of points,
+/// followed by one point per line. The layout is given by the first line
+/// with at least three numbers.
+bool ReadPointCloudFromPTSBuffer(const char *data,
+                                 size_t size,
+                                 geometry::PointCloud &pointcloud,
+                                 const ReadPointCloudOption &params) {
+    const char *end = data + size;
+    const char *line = data;
+    size_t num_points = 0;
+    bool has_header = false;
+    int num_columns = 0;
+    while (line < end) {
+        num_columns = column_text::CountColumns(line, end);
+        if (num_columns >= 3) {
+            break;
+        }
+        if (num_columns == 1 && !has_header) {
+            const char *p = line;
+            while (p < end && (*p == ' ' || *p == '\t')) {
+                p++;
+            }
+            has_header = std::from_chars(p, end, num_points).ec == std::errc();
+        }
+        const char *line_end = static_cast<const char *>(
+                std::memchr(line, '\n', end - line));
+        line = line_end ? line_end + 1 : end;
+    }
+    if (!column_text::ReadPointCloud(line, end - line,
+                                     GetPTSLayout(num_columns), pointcloud,
+                                     params)) {
+        return false;
+    }
+    if (has_header && pointcloud.points_.size() != num_points) {
+        if (pointcloud.points_.size() < num_points) {
+            utility::LogWarning(
+                    "Read PTS: expected {:d} points, only {:d} were read.",
+                    num_points, pointcloud.points_.size());
+        } else {
+            if (pointcloud.HasColors()) {
+                pointcloud.colors_.resize(num_points);
+            }
+            pointcloud.points_.resize(num_points);
+        }
+    }
+    return true;
+}
+
+/// Writes x y z, or x y z i r g b with a zero intensity if the point cloud
+/// has colors.
+column_text::ColumnLayout GetPTSLayout(const geometry::PointCloud &pointcloud) {
+    return GetPTSLayout(pointcloud.HasColors() ? 7 : 3);
+}
+
+}  // unnamed namespace
+/// @endcond
+
+FileGeometry ReadFileGeometryTypePTS(const std::string &path) {
+    return CONTAINS_POINTS;
+}
+
+bool ReadPointCloudFromPTS(const std::string &filename,
+                           geometry::PointCloud &pointcloud,
+                           const ReadPointCloudOption &params) {
+    try {
+        utility::filesystem::MappedFile file;
+        if (!file.Open(filename)) {
+            utility::LogWarning("Read PTS failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        return ReadPointCloudFromPTSBuffer(file.GetData(), file.GetSize(),
+                                           pointcloud, params);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read PTS failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool ReadPointCloudInMemoryFromPTS(const unsigned char *buffer,
+                                   const size_t length,
+                                   geometry::PointCloud &pointcloud,
+                                   const ReadPointCloudOption &params) {
+    try {
+        return ReadPointCloudFromPTSBuffer(
+                reinterpret_cast<const char *>(buffer), length, pointcloud,
+                params);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read PTS failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool WritePointCloudToPTS(const std::string &filename,
+                          const geometry::PointCloud &pointcloud,
+                          const WritePointCloudOption &params) {
+    try {
+        utility::filesystem::CFile file;
+        if (!file.Open(filename, "w")) {
+            utility::LogWarning("Write PTS failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        if (fprintf(file.GetFILE(), "%zu\n", pointcloud.points_.size()) < 0) {
+            utility::LogWarning("Write PTS failed: unable to write file: {}",
+                                filename);
+            return false;
+        }
+        return column_text::WritePointCloud(
+                pointcloud, GetPTSLayout(pointcloud), params,
+                [&](const char *text, size_t size) {
+                    if (fwrite(text, 1, size, file.GetFILE()) != size) {
+                        utility::LogWarning(
+                                "Write PTS failed: unable to write file: {}",
+                                filename);
+                        return false;
+                    }
+                    return true;
+                });
+    } catch (const std::exception &e) {
+        utility::LogWarning("Write PTS failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool WritePointCloudInMemoryToPTS(unsigned char *&buffer,
+                                  size_t &length,
+                                  const geometry::PointCloud &pointcloud,
+                                  const WritePointCloudOption &params) {
+    try {
+        const std::string header =
+                std::to_string(pointcloud.points_.size()) + "\n";
+        std::vector<char> content(header.begin(), header.end());
+        column_text::WritePointCloud(pointcloud, GetPTSLayout(pointcloud),
+                                     params,
+                                     [&](const char *text, size_t size) {
+                                         content.insert(content.end(), text,
+                                                        text + size);
+                                         return true;
+                                     });
+        length = content.size();
+        buffer = new unsigned char[length];  // we do this for the caller
+        std::memcpy(buffer, content.data(), length);
+        return true;
+    } catch (const std::exception &e) {
+        utility::LogWarning("Write PTS failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+}  // namespace io
+}  // namespace tiny3d
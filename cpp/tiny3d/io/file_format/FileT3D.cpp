@@ -0,0 +1,319 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "tiny3d/io/FeatureIO.h"
+#include "tiny3d/io/FileFormatIO.h"
+#include "tiny3d/io/PointCloudIO.h"
+#include "tiny3d/io/file_format/BinaryContainer.h"
+#include "tiny3d/utility/FileSystem.h"
+#include "tiny3d/utility/Logging.h"
+#include "tiny3d/utility/ProgressReporters.h"
+
+// The tiny3d native point cloud format is a binary container (see
+// BinaryContainer.h) with 3 x N arrays "points" and, optionally, "normals"
+// and "colors". Features are stored in the same container as a D x N array
+// "feature".
+
+namespace tiny3d {
+namespace io {
+
+/// @cond
+namespace {
+
+/// Copies the 3 x N array \p name, if present, into \p attribute.
+bool ReadT3DAttribute(const std::vector<binary_container::StoredArray> &arrays,
+                      const std::string &name,
+                      int64_t n,
+                      std::vector<Eigen::Vector3d> &attribute) {
+    const binary_container::StoredArray *array =
+            binary_container::FindArray(arrays, name);
+    if (array == nullptr) {
+        return true;
+    }
+    if (array->rows != 3 || (n >= 0 && array->cols != n)) {
+        utility::LogWarning("Read T3D failed: invalid {} array.", name);
+        return false;
+    }
+    // Eigen::Vector3d is three packed doubles.
+    attribute.resize(array->cols);
+    if (!binary_container::CopyArray(
+                *array, reinterpret_cast<double *>(attribute.data()))) {
+        utility::LogWarning("Read T3D failed: corrupted {} array.", name);
+        return false;
+    }
+    return true;
+}
+
+bool ReadT3D(const char *data,
+             size_t size,
+             geometry::PointCloud &pointcloud,
+             const ReadPointCloudOption &params) {
+    utility::CountingProgressReporter reporter(params.update_progress);
+    std::vector<binary_container::StoredArray> arrays;
+    if (!binary_container::ReadArrays(data, size, "Read T3D failed",
+                                      arrays)) {
+        return false;
+    }
+    if (binary_container::FindArray(arrays, "points") == nullptr) {
+        utility::LogWarning("Read T3D failed: no points.");
+        return false;
+    }
+    pointcloud.Clear();
+    if (!ReadT3DAttribute(arrays, "points", -1, pointcloud.points_)) {
+        pointcloud.Clear();
+        return false;
+    }
+    const int64_t n = static_cast<int64_t>(pointcloud.points_.size());
+    if (!ReadT3DAttribute(arrays, "normals", n, pointcloud.normals_) ||
+        !ReadT3DAttribute(arrays, "colors", n, pointcloud.colors_)) {
+        pointcloud.Clear();
+        return false;
+    }
+    reporter.Finish();
+    return true;
+}
+
+bool WriteT3D(const geometry::PointCloud &pointcloud,
+              const WritePointCloudOption &params,
+              const std::function<bool(const char *, size_t)> &write) {
+    utility::CountingProgressReporter reporter(params.update_progress);
+    const binary_container::ScalarType type =
+            params.write_float32 ? binary_container::ScalarType::Float32
+                                 : binary_container::ScalarType::Float64;
+    const int64_t n = static_cast<int64_t>(pointcloud.points_.size());
+    std::vector<binary_container::ArrayToWrite> arrays;
+    auto values = [](const std::vector<Eigen::Vector3d> &attribute) {
+        return reinterpret_cast<const double *>(attribute.data());
+    };
+    const bool compressed = bool(params.compressed);
+    arrays.push_back(
+            {"points", 3, n, values(pointcloud.points_), type, compressed});
+    if (pointcloud.HasNormals()) {
+        arrays.push_back({"normals", 3, n, values(pointcloud.normals_), type,
+                          compressed});
+    }
+    if (pointcloud.HasColors()) {
+        arrays.push_back({"colors", 3, n, values(pointcloud.colors_), type,
+                          compressed});
+    }
+    if (!binary_container::WriteArrays(arrays, params.write_checksum,
+                                       write)) {
+        return false;
+    }
+    reporter.Finish();
+    return true;
+}
+
+bool ReadT3DFeature(const char *data,
+                    size_t size,
+                    pipelines::registration::Feature &feature) {
+    std::vector<binary_container::StoredArray> arrays;
+    if (!binary_container::ReadArrays(data, size, "Read T3D failed",
+                                      arrays)) {
+        return false;
+    }
+    const binary_container::StoredArray *array =
+            binary_container::FindArray(arrays, "feature");
+    if (array == nullptr) {
+        utility::LogWarning("Read T3D failed: no feature.");
+        return false;
+    }
+    feature.data_.resize(array->rows, array->cols);
+    if (!binary_container::CopyArray(*array, feature.data_.data())) {
+        utility::LogWarning("Read T3D failed: corrupted feature array.");
+        feature.data_.resize(0, 0);
+        return false;
+    }
+    return true;
+}
+
+bool WriteT3DFeature(const pipelines::registration::Feature &feature,
+                     bool write_float32,
+                     bool compressed,
+                     bool write_checksum,
+                     const std::function<bool(const char *, size_t)> &write) {
+    // Eigen::MatrixXd is column major, one feature per column.
+    const binary_container::ScalarType type =
+            write_float32 ? binary_container::ScalarType::Float32
+                          : binary_container::ScalarType::Float64;
+    return binary_container::WriteArrays(
+            {{"feature", feature.data_.rows(), feature.data_.cols(),
+              feature.data_.data(), type, compressed}},
+            write_checksum, write);
+}
+
+/// Returns a function writing to \p file, for WriteT3D and WriteT3DFeature.
+std::function<bool(const char *, size_t)> T3DFileWriter(
+        utility::filesystem::CFile &file, const std::string &filename) {
+    return [&file, filename](const char *data, size_t size) {
+        if (fwrite(data, 1, size, file.GetFILE()) != size) {
+            utility::LogWarning("Write T3D failed: unable to write file: {}",
+                                filename);
+            return false;
+        }
+        return true;
+    };
+}
+
+/// Passes the output of \p write_t3d, a WriteT3D or WriteT3DFeature call, to
+/// a new buffer for the caller.
+template <typename WriteT3DFunction>
+bool WriteT3DInMemory(unsigned char *&buffer,
+                      size_t &length,
+                      const WriteT3DFunction &write_t3d) {
+    std::vector<char> content;
+    if (!write_t3d([&](const char *data, size_t size) {
+            content.insert(content.end(), data, data + size);
+            return true;
+        })) {
+        return false;
+    }
+    length = content.size();
+    buffer = new unsigned char[length];  // we do this for the caller
+    std::memcpy(buffer, content.data(), length);
+    return true;
+}
+
+}  // unnamed namespace
+/// @endcond
+
+FileGeometry ReadFileGeometryTypeT3D(const std::string &path) {
+    return CONTAINS_POINTS;
+}
+
+bool ReadPointCloudFromT3D(const std::string &filename,
+                           geometry::PointCloud &pointcloud,
+                           const ReadPointCloudOption &params) {
+    try {
+        utility::filesystem::MappedFile file;
+        if (!file.Open(filename)) {
+            utility::LogWarning("Read T3D failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        return ReadT3D(file.GetData(), file.GetSize(), pointcloud, params);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read T3D failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool ReadPointCloudInMemoryFromT3D(const unsigned char *buffer,
+                                   const size_t length,
+                                   geometry::PointCloud &pointcloud,
+                                   const ReadPointCloudOption &params) {
+    try {
+        return ReadT3D(reinterpret_cast<const char *>(buffer), length,
+                       pointcloud, params);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read T3D failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool WritePointCloudToT3D(const std::string &filename,
+                          const geometry::PointCloud &pointcloud,
+                          const WritePointCloudOption &params) {
+    try {
+        utility::filesystem::CFile file;
+        if (!file.Open(filename, "wb")) {
+            utility::LogWarning("Write T3D failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        return WriteT3D(pointcloud, params, T3DFileWriter(file, filename));
+    } catch (const std::exception &e) {
+        utility::LogWarning("Write T3D failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool WritePointCloudInMemoryToT3D(unsigned char *&buffer,
+                                  size_t &length,
+                                  const geometry::PointCloud &pointcloud,
+                                  const WritePointCloudOption &params) {
+    try {
+        return WriteT3DInMemory(buffer, length, [&](const auto &write) {
+            return WriteT3D(pointcloud, params, write);
+        });
+    } catch (const std::exception &e) {
+        utility::LogWarning("Write T3D failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool ReadFeatureFromT3D(const std::string &filename,
+                        pipelines::registration::Feature &feature) {
+    try {
+        utility::filesystem::MappedFile file;
+        if (!file.Open(filename)) {
+            utility::LogWarning("Read T3D failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        return ReadT3DFeature(file.GetData(), file.GetSize(), feature);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read T3D failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool ReadFeatureInMemoryFromT3D(const unsigned char *buffer,
+                                const size_t length,
+                                pipelines::registration::Feature &feature) {
+    try {
+        return ReadT3DFeature(reinterpret_cast<const char *>(buffer), length,
+                              feature);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read T3D failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool WriteFeatureToT3D(const std::string &filename,
+                       const pipelines::registration::Feature &feature,
+                       bool write_float32,
+                       bool compressed,
+                       bool write_checksum) {
+    try {
+        utility::filesystem::CFile file;
+        if (!file.Open(filename, "wb")) {
+            utility::LogWarning("Write T3D failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        return WriteT3DFeature(feature, write_float32, compressed,
+                               write_checksum, T3DFileWriter(file, filename));
+    } catch (const std::exception &e) {
+        utility::LogWarning("Write T3D failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool WriteFeatureInMemoryToT3D(unsigned char *&buffer,
+                               size_t &length,
+                               const pipelines::registration::Feature &feature,
+                               bool write_float32,
+                               bool compressed,
+                               bool write_checksum) {
+    try {
+        return WriteT3DInMemory(buffer, length, [&](const auto &write) {
+            return WriteT3DFeature(feature, write_float32, compressed,
+                                   write_checksum, write);
+        });
+    } catch (const std::exception &e) {
+        utility::LogWarning("Write T3D failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+}  // namespace io
+}  // namespace tiny3d
@@ -6,14 +6,15 @@
 // ----------------------------------------------------------------------------
 
 #include <cstdio>
-#include <sstream>
+#include <cstring>
+#include <vector>
 
 #include "tiny3d/io/FileFormatIO.h"
 #include "tiny3d/io/PointCloudIO.h"
+#include "tiny3d/io/PointCloudReader.h"
+#include "tiny3d/io/file_format/ColumnTextIO.h"
 #include "tiny3d/utility/FileSystem.h"
-#include "tiny3d/utility/Helper.h"
 #include "tiny3d/utility/Logging.h"
-#include "tiny3d/utility/ProgressReporters.h"
 
 namespace tiny3d {
 namespace io {
@@ -26,30 +27,15 @@ bool ReadPointCloudFromXYZ(const std::string &filename,
                            geometry::PointCloud &pointcloud,
                            const ReadPointCloudOption &params) {
     try {
-        utility::filesystem::CFile file;
-        if (!file.Open(filename, "r")) {
+        utility::filesystem::MappedFile file;
+        if (!file.Open(filename)) {
             utility::LogWarning("Read XYZ failed: unable to open file: {}",
                                 filename);
             return false;
         }
-        utility::CountingProgressReporter reporter(params.update_progress);
-        reporter.SetTotal(file.GetFileSize());
-
-        pointcloud.Clear();
-        int i = 0;
-        double x, y, z;
-        const char *line_buffer;
-        while ((line_buffer = file.ReadLine())) {
-            if (sscanf(line_buffer, "%lf %lf %lf", &x, &y, &z) == 3) {
-                pointcloud.points_.push_back(Eigen::Vector3d(x, y, z));
-            }
-            if (++i % 1000 == 0) {
-                reporter.Update(file.CurPos());
-            }
-        }
-        reporter.Finish();
-
-        return true;
+        return column_text::ReadPointCloud(file.GetData(), file.GetSize(),
+                                           column_text::ColumnLayout(),
+                                           pointcloud, params);
     } catch (const std::exception &e) {
         utility::LogWarning("Read XYZ failed with exception: {}", e.what());
         return false;
@@ -61,26 +47,9 @@ bool ReadPointCloudInMemoryFromXYZ(const unsigned char *buffer,
                                    geometry::PointCloud &pointcloud,
                                    const ReadPointCloudOption &params) {
     try {
-        utility::CountingProgressReporter reporter(params.update_progress);
-        reporter.SetTotal(static_cast<int64_t>(length));
-
-        std::string content(reinterpret_cast<const char *>(buffer), length);
-        std::istringstream ibs(content);
-        pointcloud.Clear();
-        int i = 0;
-        double x, y, z;
-        std::string line;
-        while (std::getline(ibs, line)) {
-            if (sscanf(line.c_str(), "%lf %lf %lf", &x, &y, &z) == 3) {
-                pointcloud.points_.push_back(Eigen::Vector3d(x, y, z));
-            }
-            if (++i % 1000 == 0) {
-                reporter.Update(ibs.tellg());
-            }
-        }
-        reporter.Finish();
-
-        return true;
+        return column_text::ReadPointCloud(
+                reinterpret_cast<const char *>(buffer), length,
+                column_text::ColumnLayout(), pointcloud, params);
     } catch (const std::exception &e) {
         utility::LogWarning("Read XYZ failed with exception: {}", e.what());
         return false;
@@ -97,23 +66,17 @@ bool WritePointCloudToXYZ(const std::string &filename,
                                 filename);
             return false;
         }
-        utility::CountingProgressReporter reporter(params.update_progress);
-        reporter.SetTotal(pointcloud.points_.size());
-
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const Eigen::Vector3d &point = pointcloud.points_[i];
-            if (fprintf(file.GetFILE(), "%.10f %.10f %.10f\n", point(0),
-                        point(1), point(2)) < 0) {
-                utility::LogWarning(
-                        "Write XYZ failed: unable to write file: {}", filename);
-                return false;  // error happened during writing.
-            }
-            if (i % 1000 == 0) {
-                reporter.Update(i);
-            }
-        }
-        reporter.Finish();
-        return true;
+        return column_text::WritePointCloud(
+                pointcloud, column_text::ColumnLayout(), params,
+                [&](const char *text, size_t size) {
+                    if (fwrite(text, 1, size, file.GetFILE()) != size) {
+                        utility::LogWarning(
+                                "Write XYZ failed: unable to write file: {}",
+                                filename);
+                        return false;
+                    }
+                    return true;
+                });
     } catch (const std::exception &e) {
         utility::LogWarning("Write XYZ failed with exception: {}", e.what());
         return false;
@@ -125,29 +88,21 @@ bool WritePointCloudInMemoryToXYZ(unsigned char *&buffer,
                                   const geometry::PointCloud &pointcloud,
                                   const WritePointCloudOption &params) {
     try {
-        utility::CountingProgressReporter reporter(params.update_progress);
-        reporter.SetTotal(pointcloud.points_.size());
-
-        std::string content;
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const Eigen::Vector3d &point = pointcloud.points_[i];
-            std::string line = utility::FastFormatString(
-                    "%.10f %.10f %.10f\n", point(0), point(1), point(2));
-            content.append(line);
-            if (i % 1000 == 0) {
-                reporter.Update(i);
-            }
-        }
+        std::vector<char> content;
+        column_text::WritePointCloud(pointcloud, column_text::ColumnLayout(),
+                                     params,
+                                     [&](const char *text, size_t size) {
+                                         content.insert(content.end(), text,
+                                                        text + size);
+                                         return true;
+                                     });
         // nothing to report...
-        if (content.length() == 0) {
-            reporter.Finish();
+        if (content.empty()) {
             return false;
         }
-        length = content.length();
+        length = content.size();
         buffer = new unsigned char[length];  // we do this for the caller
-        std::memcpy(buffer, content.c_str(), length);
-
-        reporter.Finish();
+        std::memcpy(buffer, content.data(), length);
         return true;
     } catch (const std::exception &e) {
         utility::LogWarning("Write XYZ failed with exception: {}", e.what());
@@ -155,5 +110,11 @@ bool WritePointCloudInMemoryToXYZ(unsigned char *&buffer,
     }
 }
 
+std::unique_ptr<PointCloudReader> OpenPointCloudReaderForXYZ(
+        const std::string &filename) {
+    return column_text::OpenPointCloudReader(
+            filename, column_text::ColumnLayout(), "XYZ");
+}
+
 }  // namespace io
 }  // namespace tiny3d
@@ -0,0 +1,141 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "tiny3d/io/FileFormatIO.h"
+#include "tiny3d/io/PointCloudIO.h"
+#include "tiny3d/io/PointCloudReader.h"
+#include "tiny3d/io/file_format/ColumnTextIO.h"
+#include "tiny3d/utility/FileSystem.h"
+#include "tiny3d/utility/Logging.h"
+
+namespace tiny3d {
+namespace io {
+
+/// @cond
+namespace {
+
+/// x y z r g b, with colors in [0, 1].
+column_text::ColumnLayout MakeXYZRGBLayout() {
+    column_text::ColumnLayout layout;
+    layout.num_columns = 6;
+    layout.color_column = 3;
+    return layout;
+}
+
+const column_text::ColumnLayout kLayout = MakeXYZRGBLayout();
+
+}  // unnamed namespace
+/// @endcond
+
+FileGeometry ReadFileGeometryTypeXYZRGB(const std::string &path) {
+    return CONTAINS_POINTS;
+}
+
+bool ReadPointCloudFromXYZRGB(const std::string &filename,
+                              geometry::PointCloud &pointcloud,
+                              const ReadPointCloudOption &params) {
+    try {
+        utility::filesystem::MappedFile file;
+        if (!file.Open(filename)) {
+            utility::LogWarning("Read XYZRGB failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        return column_text::ReadPointCloud(file.GetData(), file.GetSize(),
+                                           kLayout, pointcloud, params);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read XYZRGB failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool ReadPointCloudInMemoryFromXYZRGB(const unsigned char *buffer,
+                                      const size_t length,
+                                      geometry::PointCloud &pointcloud,
+                                      const ReadPointCloudOption &params) {
+    try {
+        return column_text::ReadPointCloud(
+                reinterpret_cast<const char *>(buffer), length, kLayout,
+                pointcloud, params);
+    } catch (const std::exception &e) {
+        utility::LogWarning("Read XYZRGB failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool WritePointCloudToXYZRGB(const std::string &filename,
+                             const geometry::PointCloud &pointcloud,
+                             const WritePointCloudOption &params) {
+    if (!pointcloud.HasColors()) {
+        utility::LogWarning("Write XYZRGB failed: point cloud has no colors.");
+        return false;
+    }
+    try {
+        utility::filesystem::CFile file;
+        if (!file.Open(filename, "w")) {
+            utility::LogWarning("Write XYZRGB failed: unable to open file: {}",
+                                filename);
+            return false;
+        }
+        return column_text::WritePointCloud(
+                pointcloud, kLayout, params,
+                [&](const char *text, size_t size) {
+                    if (fwrite(text, 1, size, file.GetFILE()) != size) {
+                        utility::LogWarning(
+                                "Write XYZRGB failed: unable to write file: {}",
+                                filename);
+                        return false;
+                    }
+                    return true;
+                });
+    } catch (const std::exception &e) {
+        utility::LogWarning("Write XYZRGB failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+bool WritePointCloudInMemoryToXYZRGB(unsigned char *&buffer,
+                                     size_t &length,
+                                     const geometry::PointCloud &pointcloud,
+                                     const WritePointCloudOption &params) {
+    if (!pointcloud.HasColors()) {
+        utility::LogWarning("Write XYZRGB failed: point cloud has no colors.");
+        return false;
+    }
+    try {
+        std::vector<char> content;
+        column_text::WritePointCloud(pointcloud, kLayout, params,
+                                     [&](const char *text, size_t size) {
+                                         content.insert(content.end(), text,
+                                                        text + size);
+                                         return true;
+                                     });
+        // nothing to report...
+        if (content.empty()) {
+            return false;
+        }
+        length = content.size();
+        buffer = new unsigned char[length];  // we do this for the caller
+        std::memcpy(buffer, content.data(), length);
+        return true;
+    } catch (const std::exception &e) {
+        utility::LogWarning("Write XYZRGB failed with exception: {}", e.what());
+        return false;
+    }
+}
+
+std::unique_ptr<PointCloudReader> OpenPointCloudReaderForXYZRGB(
+        const std::string &filename) {
+    return column_text::OpenPointCloudReader(filename, kLayout, "XYZRGB");
+}
+
+}  // namespace io
+}  // namespace tiny3d
@@ -8,6 +8,8 @@
 #include "tiny3d/pipelines/registration/CorrespondenceChecker.h"
 
 #include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
 
 #include "tiny3d/geometry/PointCloud.h"
 #include "tiny3d/utility/Logging.h"
@@ -16,6 +18,88 @@ namespace tiny3d {
 namespace pipelines {
 namespace registration {
 
+namespace {
+
+/// Points of a batch of hypotheses packed as a structure of arrays, so that
+/// checks vectorize over hypotheses. Coordinate k of point i of hypothesis h
+/// is stored at coords[k][i * num_hypotheses + h]; invalid hypotheses are
+/// left zero.
+struct PackedBatchPoints {
+    PackedBatchPoints(const std::vector<Eigen::Vector3d> &points,
+                      const CorrespondenceSet &corres,
+                      int column,
+                      int sample_size,
+                      const std::vector<uint8_t> &valid) {
+        const int num_hypotheses = static_cast<int>(valid.size());
+        for (auto &coord : coords) {
+            coord.assign(static_cast<size_t>(sample_size) * num_hypotheses,
+                         0.0);
+        }
+        for (int h = 0; h < num_hypotheses; h++) {
+            if (!valid[h]) continue;
+            for (int i = 0; i < sample_size; i++) {
+                const Eigen::Vector3d &p =
+                        points[corres[h * sample_size + i](column)];
+                const size_t k = static_cast<size_t>(i) * num_hypotheses + h;
+                coords[0][k] = p(0);
+                coords[1][k] = p(1);
+                coords[2][k] = p(2);
+            }
+        }
+    }
+
+    std::vector<double> coords[3];
+};
+
+/// Rotations and translations of a batch of hypotheses packed as a structure
+/// of arrays: entry (r, c) of transformation h is stored at entries[r * 4 +
+/// c][h] for the top three rows.
+struct PackedBatchTransformations {
+    PackedBatchTransformations(
+            const std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                    &transformations,
+            const std::vector<uint8_t> &valid) {
+        const int num_hypotheses = static_cast<int>(valid.size());
+        for (auto &entry : entries) {
+            entry.assign(num_hypotheses, 0.0);
+        }
+        for (int h = 0; h < num_hypotheses; h++) {
+            if (!valid[h]) continue;
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 4; c++) {
+                    entries[r * 4 + c][h] = transformations[h](r, c);
+                }
+            }
+        }
+    }
+
+    std::vector<double> entries[12];
+};
+
+}  // namespace
+
+void CorrespondenceChecker::CheckBatch(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres,
+        int sample_size,
+        const std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                &transformations,
+        std::vector<uint8_t> &valid) const {
+    CorrespondenceSet sample(sample_size);
+    for (size_t h = 0; h < valid.size(); h++) {
+        if (!valid[h]) continue;
+        std::copy(corres.begin() + h * sample_size,
+                  corres.begin() + (h + 1) * sample_size, sample.begin());
+        valid[h] = Check(source, target, sample,
+                         transformations.empty()
+                                 ? Eigen::Matrix4d::Identity().eval()
+                                 : transformations[h])
+                           ? 1
+                           : 0;
+    }
+}
+
 bool CorrespondenceCheckerBasedOnEdgeLength::Check(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -41,6 +125,53 @@ bool CorrespondenceCheckerBasedOnEdgeLength::Check(
     return true;
 }
 
+void CorrespondenceCheckerBasedOnEdgeLength::CheckBatch(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres,
+        int sample_size,
+        const std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                & /*transformations*/,
+        std::vector<uint8_t> &valid) const {
+    const int num_hypotheses = static_cast<int>(valid.size());
+    const PackedBatchPoints ps(source.points_, corres, 0, sample_size, valid);
+    const PackedBatchPoints pt(target.points_, corres, 1, sample_size, valid);
+    const double similarity_threshold2 =
+            similarity_threshold_ * similarity_threshold_;
+    uint8_t *valid_data = valid.data();
+    for (int i = 0; i < sample_size; i++) {
+        for (int j = i + 1; j < sample_size; j++) {
+            const double *sxi = ps.coords[0].data() + i * num_hypotheses;
+            const double *syi = ps.coords[1].data() + i * num_hypotheses;
+            const double *szi = ps.coords[2].data() + i * num_hypotheses;
+            const double *sxj = ps.coords[0].data() + j * num_hypotheses;
+            const double *syj = ps.coords[1].data() + j * num_hypotheses;
+            const double *szj = ps.coords[2].data() + j * num_hypotheses;
+            const double *txi = pt.coords[0].data() + i * num_hypotheses;
+            const double *tyi = pt.coords[1].data() + i * num_hypotheses;
+            const double *tzi = pt.coords[2].data() + i * num_hypotheses;
+            const double *txj = pt.coords[0].data() + j * num_hypotheses;
+            const double *tyj = pt.coords[1].data() + j * num_hypotheses;
+            const double *tzj = pt.coords[2].data() + j * num_hypotheses;
+#pragma omp simd
+            for (int h = 0; h < num_hypotheses; h++) {
+                const double dsx = sxi[h] - sxj[h];
+                const double dsy = syi[h] - syj[h];
+                const double dsz = szi[h] - szj[h];
+                const double dtx = txi[h] - txj[h];
+                const double dty = tyi[h] - tyj[h];
+                const double dtz = tzi[h] - tzj[h];
+                const double dis_source2 = dsx * dsx + dsy * dsy + dsz * dsz;
+                const double dis_target2 = dtx * dtx + dty * dty + dtz * dtz;
+                const bool similar =
+                        !(dis_source2 < dis_target2 * similarity_threshold2 ||
+                          dis_target2 < dis_source2 * similarity_threshold2);
+                valid_data[h] &= static_cast<uint8_t>(similar);
+            }
+        }
+    }
+}
+
 bool CorrespondenceCheckerBasedOnDistance::Check(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -59,6 +190,48 @@ bool CorrespondenceCheckerBasedOnDistance::Check(
     return true;
 }
 
+void CorrespondenceCheckerBasedOnDistance::CheckBatch(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres,
+        int sample_size,
+        const std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                &transformations,
+        std::vector<uint8_t> &valid) const {
+    const int num_hypotheses = static_cast<int>(valid.size());
+    const PackedBatchPoints ps(source.points_, corres, 0, sample_size, valid);
+    const PackedBatchPoints pt(target.points_, corres, 1, sample_size, valid);
+    const PackedBatchTransformations T(transformations, valid);
+    const double *r00 = T.entries[0].data(), *r01 = T.entries[1].data(),
+                 *r02 = T.entries[2].data(), *t0 = T.entries[3].data();
+    const double *r10 = T.entries[4].data(), *r11 = T.entries[5].data(),
+                 *r12 = T.entries[6].data(), *t1 = T.entries[7].data();
+    const double *r20 = T.entries[8].data(), *r21 = T.entries[9].data(),
+                 *r22 = T.entries[10].data(), *t2 = T.entries[11].data();
+    const double distance_threshold2 = distance_threshold_ * distance_threshold_;
+    uint8_t *valid_data = valid.data();
+    for (int i = 0; i < sample_size; i++) {
+        const double *sx = ps.coords[0].data() + i * num_hypotheses;
+        const double *sy = ps.coords[1].data() + i * num_hypotheses;
+        const double *sz = ps.coords[2].data() + i * num_hypotheses;
+        const double *tx = pt.coords[0].data() + i * num_hypotheses;
+        const double *ty = pt.coords[1].data() + i * num_hypotheses;
+        const double *tz = pt.coords[2].data() + i * num_hypotheses;
+#pragma omp simd
+        for (int h = 0; h < num_hypotheses; h++) {
+            const double dx = r00[h] * sx[h] + r01[h] * sy[h] +
+                              r02[h] * sz[h] + t0[h] - tx[h];
+            const double dy = r10[h] * sx[h] + r11[h] * sy[h] +
+                              r12[h] * sz[h] + t1[h] - ty[h];
+            const double dz = r20[h] * sx[h] + r21[h] * sy[h] +
+                              r22[h] * sz[h] + t2[h] - tz[h];
+            const bool close =
+                    dx * dx + dy * dy + dz * dz <= distance_threshold2;
+            valid_data[h] &= static_cast<uint8_t>(close);
+        }
+    }
+}
+
 bool CorrespondenceCheckerBasedOnNormal::Check(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -82,6 +255,51 @@ bool CorrespondenceCheckerBasedOnNormal::Check(
     return true;
 }
 
+void CorrespondenceCheckerBasedOnNormal::CheckBatch(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres,
+        int sample_size,
+        const std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                &transformations,
+        std::vector<uint8_t> &valid) const {
+    if (!source.HasNormals() || !target.HasNormals()) {
+        utility::LogWarning(
+                "[CorrespondenceCheckerBasedOnNormal::CheckBatch] Pointcloud "
+                "has no normals.");
+        return;
+    }
+    const int num_hypotheses = static_cast<int>(valid.size());
+    const PackedBatchPoints ns(source.normals_, corres, 0, sample_size, valid);
+    const PackedBatchPoints nt(target.normals_, corres, 1, sample_size, valid);
+    const PackedBatchTransformations T(transformations, valid);
+    const double *r00 = T.entries[0].data(), *r01 = T.entries[1].data(),
+                 *r02 = T.entries[2].data();
+    const double *r10 = T.entries[4].data(), *r11 = T.entries[5].data(),
+                 *r12 = T.entries[6].data();
+    const double *r20 = T.entries[8].data(), *r21 = T.entries[9].data(),
+                 *r22 = T.entries[10].data();
+    const double cos_normal_angle_threshold = std::cos(normal_angle_threshold_);
+    uint8_t *valid_data = valid.data();
+    for (int i = 0; i < sample_size; i++) {
+        const double *sx = ns.coords[0].data() + i * num_hypotheses;
+        const double *sy = ns.coords[1].data() + i * num_hypotheses;
+        const double *sz = ns.coords[2].data() + i * num_hypotheses;
+        const double *tx = nt.coords[0].data() + i * num_hypotheses;
+        const double *ty = nt.coords[1].data() + i * num_hypotheses;
+        const double *tz = nt.coords[2].data() + i * num_hypotheses;
+#pragma omp simd
+        for (int h = 0; h < num_hypotheses; h++) {
+            const double nx = r00[h] * sx[h] + r01[h] * sy[h] + r02[h] * sz[h];
+            const double ny = r10[h] * sx[h] + r11[h] * sy[h] + r12[h] * sz[h];
+            const double nz = r20[h] * sx[h] + r21[h] * sy[h] + r22[h] * sz[h];
+            const bool similar = tx[h] * nx + ty[h] * ny + tz[h] * nz >=
+                                 cos_normal_angle_threshold;
+            valid_data[h] &= static_cast<uint8_t>(similar);
+        }
+    }
+}
+
 }  // namespace registration
 }  // namespace pipelines
 }  // namespace tiny3d
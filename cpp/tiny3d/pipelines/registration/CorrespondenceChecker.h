@@ -8,11 +8,13 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "tiny3d/pipelines/registration/TransformationEstimation.h"
+#include "tiny3d/utility/Eigen.h"
 
 namespace tiny3d {
 
@@ -52,6 +54,30 @@ public:
                        const CorrespondenceSet &corres,
                        const Eigen::Matrix4d &transformation) const = 0;
 
+    /// \brief Function to check a batch of hypotheses at once.
+    ///
+    /// Hypothesis h consists of the correspondences
+    /// corres[h * sample_size, (h + 1) * sample_size) and, for checkers that
+    /// require point cloud alignment, of transformations[h]. Otherwise
+    /// \p transformations may be empty. Hypotheses with valid[h] == 0 are
+    /// skipped; valid[h] is set to 0 for hypotheses that fail the check. The
+    /// default implementation calls Check() for every hypothesis.
+    ///
+    /// \param source Source point cloud.
+    /// \param target Target point cloud.
+    /// \param corres Correspondences of all hypotheses, concatenated.
+    /// \param sample_size Number of correspondences per hypothesis.
+    /// \param transformations The estimated transformation of every hypothesis.
+    /// \param valid Validity flag of every hypothesis.
+    virtual void CheckBatch(
+            const geometry::PointCloud &source,
+            const geometry::PointCloud &target,
+            const CorrespondenceSet &corres,
+            int sample_size,
+            const std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                    &transformations,
+            std::vector<uint8_t> &valid) const;
+
 public:
     /// Some checkers do not require point clouds to be aligned, e.g., the edge
     /// length checker. Some checkers do, e.g., the distance checker.
@@ -83,6 +109,14 @@ public:
                const geometry::PointCloud &target,
                const CorrespondenceSet &corres,
                const Eigen::Matrix4d &transformation) const override;
+    void CheckBatch(
+            const geometry::PointCloud &source,
+            const geometry::PointCloud &target,
+            const CorrespondenceSet &corres,
+            int sample_size,
+            const std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                    &transformations,
+            std::vector<uint8_t> &valid) const override;
 
 public:
     /// For the check to be true,
@@ -110,6 +144,14 @@ public:
                const geometry::PointCloud &target,
                const CorrespondenceSet &corres,
                const Eigen::Matrix4d &transformation) const override;
+    void CheckBatch(
+            const geometry::PointCloud &source,
+            const geometry::PointCloud &target,
+            const CorrespondenceSet &corres,
+            int sample_size,
+            const std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                    &transformations,
+            std::vector<uint8_t> &valid) const override;
 
 public:
     /// Distance threshold for the check.
@@ -137,6 +179,14 @@ public:
                const geometry::PointCloud &target,
                const CorrespondenceSet &corres,
                const Eigen::Matrix4d &transformation) const override;
+    void CheckBatch(
+            const geometry::PointCloud &source,
+            const geometry::PointCloud &target,
+            const CorrespondenceSet &corres,
+            int sample_size,
+            const std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                    &transformations,
+            std::vector<uint8_t> &valid) const override;
 
 public:
     /// Radian value for angle threshold.
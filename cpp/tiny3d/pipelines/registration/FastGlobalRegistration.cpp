@@ -0,0 +1,263 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/pipelines/registration/FastGlobalRegistration.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+
+#include "tiny3d/geometry/PointCloud.h"
+#include "tiny3d/pipelines/registration/Feature.h"
+#include "tiny3d/utility/Eigen.h"
+#include "tiny3d/utility/Logging.h"
+#include "tiny3d/utility/Parallel.h"
+#include "tiny3d/utility/Random.h"
+
+namespace tiny3d {
+namespace pipelines {
+namespace registration {
+
+/// Keeps the correspondences of random triplets whose pairwise distances
+/// agree between source and target up to option.tuple_scale_.
+static CorrespondenceSet AdvancedMatching(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres,
+        const FastGlobalRegistrationOption &option) {
+    const int num_corres = static_cast<int>(corres.size());
+    const int64_t num_trials = static_cast<int64_t>(num_corres) * 100;
+    const double scale = option.tuple_scale_;
+
+    // Trials run in rounds of chunks that are processed in parallel. Every
+    // chunk samples from its own random stream, and accepted tuples are
+    // concatenated in chunk order, so the result does not depend on the
+    // number of threads.
+    constexpr int kTrialChunk = 1024;
+    const int num_chunks_per_round = 4 * utility::EstimateMaxThreads();
+    const int64_t num_chunks = (num_trials + kTrialChunk - 1) / kTrialChunk;
+    const uint64_t seed = utility::random::RandUint32();
+
+    CorrespondenceSet corres_tuple;
+    int num_tuples = 0;
+    std::vector<CorrespondenceSet> chunk_tuples(num_chunks_per_round);
+    for (int64_t round_begin = 0;
+         round_begin < num_chunks && num_tuples < option.maximum_tuple_count_;
+         round_begin += num_chunks_per_round) {
+        const int round_size = static_cast<int>(std::min<int64_t>(
+                num_chunks_per_round, num_chunks - round_begin));
+#pragma omp parallel for schedule(dynamic, 1) \
+        num_threads(utility::EstimateMaxThreads())
+        for (int c = 0; c < round_size; c++) {
+            const int64_t chunk = round_begin + c;
+            const int64_t trial_end =
+                    std::min(num_trials, (chunk + 1) * kTrialChunk);
+            utility::random::LocalUniformIntGenerator<int> rand_gen(
+                    0, num_corres - 1, seed, static_cast<uint64_t>(chunk));
+            CorrespondenceSet &tuples = chunk_tuples[c];
+            tuples.clear();
+            for (int64_t trial = chunk * kTrialChunk; trial < trial_end;
+                 trial++) {
+                const Eigen::Vector2i &c0 = corres[rand_gen()];
+                const Eigen::Vector2i &c1 = corres[rand_gen()];
+                const Eigen::Vector2i &c2 = corres[rand_gen()];
+
+                const Eigen::Vector3d &ps0 = source.points_[c0(0)];
+                const Eigen::Vector3d &ps1 = source.points_[c1(0)];
+                const Eigen::Vector3d &ps2 = source.points_[c2(0)];
+                const Eigen::Vector3d &pt0 = target.points_[c0(1)];
+                const Eigen::Vector3d &pt1 = target.points_[c1(1)];
+                const Eigen::Vector3d &pt2 = target.points_[c2(1)];
+
+                const double ls0 = (ps0 - ps1).norm();
+                const double ls1 = (ps1 - ps2).norm();
+                const double ls2 = (ps2 - ps0).norm();
+                const double lt0 = (pt0 - pt1).norm();
+                const double lt1 = (pt1 - pt2).norm();
+                const double lt2 = (pt2 - pt0).norm();
+
+                if ((ls0 * scale < lt0) && (lt0 < ls0 / scale) &&
+                    (ls1 * scale < lt1) && (lt1 < ls1 / scale) &&
+                    (ls2 * scale < lt2) && (lt2 < ls2 / scale)) {
+                    tuples.push_back(c0);
+                    tuples.push_back(c1);
+                    tuples.push_back(c2);
+                }
+            }
+        }
+        for (int c = 0; c < round_size &&
+                        num_tuples < option.maximum_tuple_count_;
+             c++) {
+            const CorrespondenceSet &tuples = chunk_tuples[c];
+            for (size_t k = 0; k < tuples.size() &&
+                               num_tuples < option.maximum_tuple_count_;
+                 k += 3) {
+                corres_tuple.push_back(tuples[k]);
+                corres_tuple.push_back(tuples[k + 1]);
+                corres_tuple.push_back(tuples[k + 2]);
+                num_tuples++;
+            }
+        }
+    }
+    utility::LogDebug("{:d} tuples ({:d} trials, {:d} correspondences).",
+                      num_tuples, num_trials, num_corres);
+    return corres_tuple;
+}
+
+/// Centroid of \p pointcloud and the largest distance of a point to it.
+static std::tuple<Eigen::Vector3d, double> ComputeCenterAndRadius(
+        const geometry::PointCloud &pointcloud) {
+    const Eigen::Vector3d center = pointcloud.GetCenter();
+    double radius2 = 0.0;
+    for (const auto &point : pointcloud.points_) {
+        radius2 = std::max(radius2, (point - center).squaredNorm());
+    }
+    return std::make_tuple(center, std::sqrt(radius2));
+}
+
+/// Minimizes the scaled Geman-McClure cost of the correspondence residuals
+/// with the line process formulation, where mu is decreased for graduated
+/// non-convexity. Points are given centered and normalized.
+static Eigen::Matrix4d OptimizePairwiseRegistration(
+        const std::vector<Eigen::Vector3d> &source_points,
+        const std::vector<Eigen::Vector3d> &target_points,
+        double mu,
+        const FastGlobalRegistrationOption &option) {
+    const int num_corres = static_cast<int>(source_points.size());
+    std::vector<Eigen::Vector3d> transformed_points = source_points;
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+
+    for (int itr = 0; itr < option.iteration_number_; itr++) {
+        // Graduated non-convexity, mu is divided before the iterations 0, 4,
+        // 8, ... as in the reference implementation.
+        if (option.decrease_mu_ && itr % 4 == 0 &&
+            mu > option.maximum_correspondence_distance_) {
+            mu /= option.division_factor_;
+        }
+
+        // Every correspondence contributes one row per coordinate, weighted
+        // by l^2, the square of its line process l = mu / (mu + r^2).
+        auto compute_jacobian_and_residual =
+                [&](int i,
+                    std::vector<Eigen::Vector6d, utility::Vector6d_allocator>
+                            &J_r,
+                    std::vector<double> &r, std::vector<double> &w) {
+                    const Eigen::Vector3d &ps = transformed_points[i];
+                    const Eigen::Vector3d residual = ps - target_points[i];
+                    const double l = mu / (residual.squaredNorm() + mu);
+                    J_r.resize(3);
+                    r.resize(3);
+                    w.resize(3);
+                    for (int k = 0; k < 3; k++) {
+                        J_r[k].block<3, 1>(0, 0) =
+                                ps.cross(Eigen::Vector3d::Unit(k));
+                        J_r[k].block<3, 1>(3, 0) = Eigen::Vector3d::Unit(k);
+                        r[k] = residual(k);
+                        w[k] = l * l;
+                    }
+                };
+        Eigen::Matrix6d JTJ;
+        Eigen::Vector6d JTr;
+        double r2;
+        std::tie(JTJ, JTr, r2) =
+                utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
+                        compute_jacobian_and_residual, num_corres, false);
+
+        bool is_success;
+        Eigen::Matrix4d delta;
+        std::tie(is_success, delta) =
+                utility::SolveJacobianSystemAndObtainExtrinsicMatrix(JTJ, JTr);
+        if (!is_success) {
+            break;
+        }
+        transformation = delta * transformation;
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+        for (int i = 0; i < num_corres; i++) {
+            transformed_points[i] = delta.block<3, 3>(0, 0) *
+                                            transformed_points[i] +
+                                    delta.block<3, 1>(0, 3);
+        }
+    }
+    return transformation;
+}
+
+RegistrationResult RegistrationFGRBasedOnCorrespondence(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres,
+        const FastGlobalRegistrationOption &option
+        /* = FastGlobalRegistrationOption()*/) {
+    if (source.IsEmpty() || target.IsEmpty() || corres.empty()) {
+        return RegistrationResult();
+    }
+
+    const CorrespondenceSet corres_tuple =
+            option.tuple_test_
+                    ? AdvancedMatching(source, target, corres, option)
+                    : corres;
+    if (corres_tuple.size() < 10) {
+        utility::LogDebug("Too few correspondences ({:d}) for FGR.",
+                          static_cast<int>(corres_tuple.size()));
+        return RegistrationResult();
+    }
+
+    // Center both point clouds, and normalize them by the larger radius
+    // unless distances are measured in absolute scale.
+    Eigen::Vector3d source_center, target_center;
+    double source_radius, target_radius;
+    std::tie(source_center, source_radius) = ComputeCenterAndRadius(source);
+    std::tie(target_center, target_radius) = ComputeCenterAndRadius(target);
+    const double max_radius = std::max(source_radius, target_radius);
+    const double scale = option.use_absolute_scale_ ? 1.0 : max_radius;
+    const double mu_start = option.use_absolute_scale_ ? max_radius : 1.0;
+    if (!(scale > 0.0)) {
+        return RegistrationResult();
+    }
+
+    const int num_corres = static_cast<int>(corres_tuple.size());
+    std::vector<Eigen::Vector3d> source_points(num_corres),
+            target_points(num_corres);
+    for (int i = 0; i < num_corres; i++) {
+        source_points[i] =
+                (source.points_[corres_tuple[i](0)] - source_center) / scale;
+        target_points[i] =
+                (target.points_[corres_tuple[i](1)] - target_center) / scale;
+    }
+    const Eigen::Matrix4d normalized_transformation =
+            OptimizePairwiseRegistration(source_points, target_points,
+                                         mu_start, option);
+
+    // Undo the normalization: q = R (p - c_s) + s t + c_t.
+    const Eigen::Matrix3d rotation = normalized_transformation.block<3, 3>(0, 0);
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) = rotation;
+    transformation.block<3, 1>(0, 3) =
+            -rotation * source_center +
+            scale * normalized_transformation.block<3, 1>(0, 3) +
+            target_center;
+    return EvaluateRegistration(source, target,
+                                option.maximum_correspondence_distance_ * scale,
+                                transformation);
+}
+
+RegistrationResult RegistrationFGRBasedOnFeatureMatching(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const Feature &source_features,
+        const Feature &target_features,
+        const FastGlobalRegistrationOption &option
+        /* = FastGlobalRegistrationOption()*/) {
+    const CorrespondenceSet corres = CorrespondencesFromFeatures(
+            source_features, target_features, /*mutual_filter=*/true);
+    return RegistrationFGRBasedOnCorrespondence(source, target, corres, option);
+}
+
+}  // namespace registration
+}  // namespace pipelines
+}  // namespace tiny3d
@@ -8,13 +8,21 @@
 #include "tiny3d/pipelines/registration/Feature.h"
 
 #include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
 #include "tiny3d/geometry/KDTreeFlann.h"
+#include "tiny3d/geometry/KDTreeForest.h"
 #include "tiny3d/geometry/PointCloud.h"
+#include "tiny3d/pipelines/registration/FeatureBruteForce.h"
 #include "tiny3d/utility/Logging.h"
 #include "tiny3d/utility/Parallel.h"
 
@@ -24,27 +32,133 @@ namespace registration {
 
 namespace {
 
-using NeighborIndices = std::vector<std::vector<int>>;
-using NeighborDistances = std::vector<std::vector<double>>;
-
+/// Neighborhoods of all points in compressed sparse row layout: the
+/// neighbors of point i are at [offsets[i], offsets[i + 1]) in indices and
+/// distance2, which avoids one allocation per point.
+struct NeighborhoodsCSR {
+    std::vector<size_t> offsets;
+    std::vector<int> indices;
+    std::vector<float> distance2;
+};
+
+/// Computes the neighborhoods of the points of \p input with the given
+/// \p points indices, row i of \p neighborhoods holds the ones of points[i].
 void ComputeNeighborhoods(const geometry::PointCloud &input,
                           const geometry::KDTreeFlann &kdtree,
                           const geometry::KDTreeSearchParam &search_param,
-                          NeighborIndices &neighbor_indices,
-                          NeighborDistances &neighbor_distance2) {
-    const size_t n_points = input.points_.size();
-    neighbor_indices.resize(n_points);
-    neighbor_distance2.resize(n_points);
+                          const std::vector<size_t> &points,
+                          NeighborhoodsCSR &neighborhoods) {
+    // Points are searched in blocks, so that the search results of only one
+    // block are held in per-point buffers before they are packed.
+    constexpr int kBlockSize = 1 << 16;
+    const int n_points = static_cast<int>(points.size());
+    neighborhoods.offsets.assign(n_points + 1, 0);
+    neighborhoods.indices.clear();
+    neighborhoods.distance2.clear();
+
+    std::vector<std::vector<int>> block_indices(
+            std::min(kBlockSize, n_points));
+    std::vector<std::vector<double>> block_distance2(block_indices.size());
+    for (int block_begin = 0; block_begin < n_points;
+         block_begin += kBlockSize) {
+        const int block_size = std::min(kBlockSize, n_points - block_begin);
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+        for (int b = 0; b < block_size; ++b) {
+            kdtree.Search(input.points_[points[block_begin + b]],
+                          search_param, block_indices[b], block_distance2[b]);
+        }
+
+        for (int b = 0; b < block_size; ++b) {
+            neighborhoods.offsets[block_begin + b + 1] =
+                    neighborhoods.offsets[block_begin + b] +
+                    block_indices[b].size();
+        }
+        const size_t block_end = neighborhoods.offsets[block_begin + block_size];
+        if (block_begin == 0) {
+            // Extrapolate the size from the first block instead of growing
+            // the buffers geometrically.
+            const size_t estimate = static_cast<size_t>(
+                    static_cast<double>(block_end) * n_points / block_size);
+            neighborhoods.indices.reserve(estimate);
+            neighborhoods.distance2.reserve(estimate);
+        }
+        neighborhoods.indices.resize(block_end);
+        neighborhoods.distance2.resize(block_end);
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+        for (int b = 0; b < block_size; ++b) {
+            const size_t offset = neighborhoods.offsets[block_begin + b];
+            std::copy(block_indices[b].begin(), block_indices[b].end(),
+                      neighborhoods.indices.begin() + offset);
+            std::copy(block_distance2[b].begin(), block_distance2[b].end(),
+                      neighborhoods.distance2.begin() + offset);
+        }
+    }
+}
+
+/// Searches the \p knn nearest neighbors of every query feature among the
+/// data features with the method selected by \p option. Neighbors of query i
+/// are stored sorted at [i * knn, (i + 1) * knn), missing ones with index -1
+/// and infinite squared distance.
+void SearchFeatureKNN(const Feature &query_features,
+                      const Feature &data_features,
+                      int knn,
+                      const FeatureMatchingOption &option,
+                      std::vector<int> &indices,
+                      std::vector<double> &distance2) {
+    const int num_queries = static_cast<int>(query_features.Num());
+    if (option.method_ == FeatureMatchingMethod::BruteForce) {
+        if (query_features.Dimension() != data_features.Dimension()) {
+            utility::LogError(
+                    "Feature dimensions do not match, got {:d} and {:d}.",
+                    static_cast<int>(query_features.Dimension()),
+                    static_cast<int>(data_features.Dimension()));
+        }
+        const Eigen::MatrixXf queries = query_features.data_.cast<float>();
+        const Eigen::MatrixXf data = data_features.data_.cast<float>();
+        std::vector<float> distance2_float;
+        brute_force::SearchKNN(queries.data(), static_cast<int>(queries.cols()),
+                               data.data(), static_cast<int>(data.cols()),
+                               static_cast<int>(data.rows()), knn, indices,
+                               distance2_float);
+        distance2.assign(distance2_float.begin(), distance2_float.end());
+        return;
+    }
 
+    indices.assign(static_cast<size_t>(num_queries) * knn, -1);
+    distance2.assign(static_cast<size_t>(num_queries) * knn,
+                     std::numeric_limits<double>::infinity());
+    const bool use_forest =
+            option.method_ == FeatureMatchingMethod::KDTreeForest;
+    geometry::KDTreeFlann kdtree;
+    geometry::KDTreeForest forest(std::max(option.num_trees_, 1));
+    if (use_forest) {
+        forest.SetFeature(data_features);
+    } else {
+        kdtree.SetFeature(data_features);
+    }
 #pragma omp parallel num_threads(utility::EstimateMaxThreads())
     {
-        std::vector<int> indices;
-        std::vector<double> distance2;
+        std::vector<int> nn_indices;
+        std::vector<double> nn_distance2;
+        nn_indices.reserve(knn);
+        nn_distance2.reserve(knn);
 #pragma omp for schedule(static)
-        for (int i = 0; i < static_cast<int>(n_points); ++i) {
-            kdtree.Search(input.points_[i], search_param, indices, distance2);
-            neighbor_indices[i] = indices;
-            neighbor_distance2[i] = distance2;
+        for (int i = 0; i < num_queries; i++) {
+            const double *query = query_features.data_.col(i).data();
+            const int query_size =
+                    static_cast<int>(query_features.data_.rows());
+            const int nn = use_forest
+                                   ? forest.SearchKNN(query, query_size, knn,
+                                                      option.max_checks_,
+                                                      nn_indices, nn_distance2)
+                                   : kdtree.SearchKNN(query, query_size, knn,
+                                                      nn_indices, nn_distance2);
+            for (int m = 0; m < nn; m++) {
+                indices[static_cast<size_t>(i) * knn + m] = nn_indices[m];
+                distance2[static_cast<size_t>(i) * knn + m] = nn_distance2[m];
+            }
         }
     }
 }
@@ -127,86 +241,142 @@ static Eigen::Vector4d ComputePairFeatures(const Eigen::Vector3d &p1,
     return result;
 }
 
-static std::shared_ptr<Feature> ComputeSPFHFeature(
+/// Computes the SPFH histograms of the points with the given \p points
+/// indices as a 33 x N single precision matrix, which halves the memory of the
+/// intermediate compared to a Feature.
+static Eigen::MatrixXf ComputeSPFHFeature(
         const geometry::PointCloud &input,
-        const NeighborIndices &neighbor_indices) {
-    const size_t n_spfh = input.points_.size();
-    auto feature = std::make_shared<Feature>();
-    feature->Resize(33, static_cast<int>(n_spfh));
+        const std::vector<size_t> &points,
+        const NeighborhoodsCSR &neighborhoods) {
+    const int n_spfh = static_cast<int>(points.size());
+    Eigen::MatrixXf spfh = Eigen::MatrixXf::Zero(33, n_spfh);
 
 #pragma omp parallel for schedule(static) num_threads(utility::EstimateMaxThreads())
-    for (int i = 0; i < static_cast<int>(n_spfh); i++) {
-        const auto &point = input.points_[i];
-        const auto &normal = input.normals_[i];
-        const auto &indices = neighbor_indices[i];
-        if (indices.size() > 1) {
-            double hist_incr = 100.0 / static_cast<double>(indices.size() - 1);
-            for (size_t k = 1; k < indices.size(); k++) {
+    for (int i = 0; i < n_spfh; i++) {
+        const auto &point = input.points_[points[i]];
+        const auto &normal = input.normals_[points[i]];
+        const size_t begin = neighborhoods.offsets[i];
+        const size_t end = neighborhoods.offsets[i + 1];
+        if (end - begin > 1) {
+            const float hist_incr =
+                    static_cast<float>(100.0 / static_cast<double>(end - begin - 1));
+            float *hist = spfh.col(i).data();
+            for (size_t k = begin + 1; k < end; k++) {
+                const int index = neighborhoods.indices[k];
                 auto pf = ComputePairFeatures(point, normal,
-                                              input.points_[indices[k]],
-                                              input.normals_[indices[k]]);
+                                              input.points_[index],
+                                              input.normals_[index]);
                 int h_index = static_cast<int>(floor(11 * (pf(0) + M_PI) / (2.0 * M_PI)));
                 h_index = std::clamp(h_index, 0, 10);
-                feature->data_(h_index, i) += hist_incr;
+                hist[h_index] += hist_incr;
 
                 h_index = static_cast<int>(floor(11 * (pf(1) + 1.0) * 0.5));
                 h_index = std::clamp(h_index, 0, 10);
-                feature->data_(h_index + 11, i) += hist_incr;
+                hist[h_index + 11] += hist_incr;
 
                 h_index = static_cast<int>(floor(11 * (pf(2) + 1.0) * 0.5));
                 h_index = std::clamp(h_index, 0, 10);
-                feature->data_(h_index + 22, i) += hist_incr;
+                hist[h_index + 22] += hist_incr;
             }
         }
     }
-    return feature;
+    return spfh;
 }
 
-std::shared_ptr<Feature> ComputeFPFHFeature(
+/// Computes the FPFH features of the points of \p input with indices in
+/// \p indices. SPFH histograms are computed only for these points and their
+/// neighbors.
+static std::shared_ptr<Feature> ComputeFPFHFeatureOnIndices(
         const geometry::PointCloud &input,
-        const geometry::KDTreeSearchParam &search_param) {
+        const geometry::KDTreeSearchParam &search_param,
+        const std::vector<size_t> &indices) {
     if (!input.HasNormals()) {
         utility::LogError("Failed because input point cloud has no normal.");
     }
 
+    // SPFH column of every point, -1 if the SPFH is not needed. The distinct
+    // query points take the first columns, their neighbors the following
+    // ones.
     const size_t n_points = input.points_.size();
-    geometry::KDTreeFlann kdtree(input);
-    NeighborIndices neighbor_indices;
-    NeighborDistances neighbor_distance2;
-    ComputeNeighborhoods(input, kdtree, search_param, neighbor_indices,
-                         neighbor_distance2);
-
-    auto feature = std::make_shared<Feature>();
-    feature->Resize(33, static_cast<int>(n_points));
+    std::vector<int> spfh_column(n_points, -1);
+    std::vector<size_t> queries;
+    for (size_t index : indices) {
+        if (index >= n_points) {
+            utility::LogError("Index {:d} out of range for {:d} points.",
+                              index, n_points);
+        }
+        if (spfh_column[index] < 0) {
+            spfh_column[index] = static_cast<int>(queries.size());
+            queries.push_back(index);
+        }
+    }
 
-    auto spfh = ComputeSPFHFeature(input, neighbor_indices);
-    if (spfh == nullptr) {
-        utility::LogError("Internal error: SPFH feature is nullptr.");
+    // The SPFH of every query point and neighbor is materialized once, in
+    // single precision: each one is summed into the FPFH of all the points of
+    // its neighborhood, so computing them per block of output points would
+    // recompute the ones shared between blocks, which is most of them when
+    // the points are not ordered spatially.
+    NeighborhoodsCSR neighborhoods;
+    Eigen::MatrixXf spfh;
+    {
+        geometry::KDTreeFlann kdtree(input);
+        ComputeNeighborhoods(input, kdtree, search_param, queries,
+                             neighborhoods);
+        std::vector<size_t> neighbors;
+        for (int index : neighborhoods.indices) {
+            if (spfh_column[index] < 0) {
+                spfh_column[index] =
+                        static_cast<int>(queries.size() + neighbors.size());
+                neighbors.push_back(index);
+            }
+        }
+        if (neighbors.empty()) {
+            spfh = ComputeSPFHFeature(input, queries, neighborhoods);
+        } else {
+            NeighborhoodsCSR neighbor_neighborhoods;
+            ComputeNeighborhoods(input, kdtree, search_param, neighbors,
+                                 neighbor_neighborhoods);
+            spfh.resize(33, queries.size() + neighbors.size());
+            spfh.leftCols(queries.size()) =
+                    ComputeSPFHFeature(input, queries, neighborhoods);
+            spfh.rightCols(neighbors.size()) = ComputeSPFHFeature(
+                    input, neighbors, neighbor_neighborhoods);
+        }
     }
 
-#pragma omp parallel for schedule(static) num_threads(utility::EstimateMaxThreads())
-    for (int i = 0; i < static_cast<int>(n_points); i++) {
-        const auto &indices = neighbor_indices[i];
-        const auto &distance2 = neighbor_distance2[i];
+    auto feature = std::make_shared<Feature>();
+    feature->Resize(33, static_cast<int>(indices.size()));
 
-        if (indices.size() > 1) {
+#pragma omp parallel for schedule(static) num_threads(utility::EstimateMaxThreads())
+    for (int i = 0; i < static_cast<int>(indices.size()); i++) {
+        const int q = spfh_column[indices[i]];
+        const size_t begin = neighborhoods.offsets[q];
+        const size_t end = neighborhoods.offsets[q + 1];
+        if (end - begin > 1) {
+            // Accumulate the weighted histograms of the neighbors locally and
+            // write the column of the output once. Blocking the output columns
+            // and grouping their neighbors by SPFH column does not pay off:
+            // the grouping costs more than the cache reuse saves.
+            double hist[33] = {0.0};
             double sum[3] = {0.0, 0.0, 0.0};
-            for (size_t k = 1; k < indices.size(); k++) {
-                double dist = distance2[k];
+            for (size_t k = begin + 1; k < end; k++) {
+                const double dist = neighborhoods.distance2[k];
                 if (dist == 0.0) continue;
-                int p_index_k = indices[k];
+                const float *spfh_k =
+                        spfh.col(spfh_column[neighborhoods.indices[k]]).data();
+                const double weight = 1.0 / dist;
                 for (int j = 0; j < 33; j++) {
-                    double val = spfh->data_(j, p_index_k) / dist;
-                    sum[j / 11] += val;
-                    feature->data_(j, i) += val;
+                    hist[j] += spfh_k[j] * weight;
                 }
             }
+            for (int j = 0; j < 33; j++) {
+                sum[j / 11] += hist[j];
+            }
             for (int j = 0; j < 3; j++) {
                 if (sum[j] != 0.0) sum[j] = 100.0 / sum[j];
             }
             for (int j = 0; j < 33; j++) {
-                feature->data_(j, i) *= sum[j / 11];
-                feature->data_(j, i) += spfh->data_(j, i);
+                feature->data_(j, i) = hist[j] * sum[j / 11] + spfh(j, q);
             }
         }
     }
@@ -219,10 +389,26 @@ std::shared_ptr<Feature> ComputeFPFHFeature(
     return feature;
 }
 
+std::shared_ptr<Feature> ComputeFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::KDTreeSearchParam &search_param) {
+    std::vector<size_t> indices(input.points_.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    return ComputeFPFHFeatureOnIndices(input, search_param, indices);
+}
+
+std::shared_ptr<Feature> ComputeFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::KDTreeSearchParam &search_param,
+        const std::vector<size_t> &indices) {
+    return ComputeFPFHFeatureOnIndices(input, search_param, indices);
+}
+
 CorrespondenceSet CorrespondencesFromFeatures(const Feature &source_features,
                                               const Feature &target_features,
                                               bool mutual_filter,
-                                              float mutual_consistent_ratio) {
+                                              float mutual_consistent_ratio,
+                                              const FeatureMatchingOption &option) {
     if (source_features.data_.cols() == 0 || target_features.data_.cols() == 0) {
         utility::LogWarning(
                 "CorrespondencesFromFeatures called with empty feature set.");
@@ -239,29 +425,13 @@ CorrespondenceSet CorrespondencesFromFeatures(const Feature &source_features,
     std::vector<CorrespondenceSet> corres(num_searches);
 
     for (int k = 0; k < num_searches; ++k) {
-        geometry::KDTreeFlann kdtree(features[1 - k]);
-
-        int num_pts_k = num_pts[k];
-        corres[k] = CorrespondenceSet(num_pts_k);
-#pragma omp parallel num_threads(utility::EstimateMaxThreads())
-        {
-            std::vector<int> corres_tmp;
-            std::vector<double> dist_tmp;
-            corres_tmp.reserve(1);
-            dist_tmp.reserve(1);
-#pragma omp for schedule(static)
-            for (int i = 0; i < num_pts_k; i++) {
-                const auto &feature = features[k].get();
-                const int nn = kdtree.SearchKNN(feature.data_.col(i).data(),
-                                               feature.data_.rows(), 1,
-                                               corres_tmp, dist_tmp);
-                if (nn > 0) {
-                    int j = corres_tmp[0];
-                    corres[k][i] = Eigen::Vector2i(i, j);
-                } else {
-                    corres[k][i] = Eigen::Vector2i(i, -1);
-                }
-            }
+        std::vector<int> nn_indices;
+        std::vector<double> nn_distance2;
+        SearchFeatureKNN(features[k], features[1 - k], 1, option, nn_indices,
+                         nn_distance2);
+        corres[k] = CorrespondenceSet(num_pts[k]);
+        for (int i = 0; i < num_pts[k]; i++) {
+            corres[k][i] = Eigen::Vector2i(i, nn_indices[i]);
         }
     }
 
@@ -302,6 +472,84 @@ CorrespondenceSet CorrespondencesFromFeatures(const Feature &source_features,
     return filter_valid_corres(corres[0]);
 }
 
+std::tuple<CorrespondenceSet, std::vector<double>>
+CorrespondencesFromFeaturesKNN(const Feature &source_features,
+                               const Feature &target_features,
+                               int knn,
+                               double ratio_threshold,
+                               const FeatureMatchingOption &option) {
+    if (knn < 1) {
+        utility::LogError("knn must be positive, but got {:d}.", knn);
+    }
+    if (source_features.data_.cols() == 0 || target_features.data_.cols() == 0) {
+        utility::LogWarning(
+                "CorrespondencesFromFeaturesKNN called with empty feature "
+                "set.");
+        return std::make_tuple(CorrespondenceSet(), std::vector<double>());
+    }
+
+    // The ratio test compares the candidates to one more neighbor.
+    const bool ratio_test = ratio_threshold < 1.0;
+    const int num_neighbors = ratio_test ? knn + 1 : knn;
+    std::vector<int> nn_indices;
+    std::vector<double> nn_distance2;
+    SearchFeatureKNN(source_features, target_features, num_neighbors, option,
+                     nn_indices, nn_distance2);
+
+    const int num_src_pts = static_cast<int>(source_features.Num());
+    const double ratio2 = ratio_threshold * ratio_threshold;
+    CorrespondenceSet corres;
+    std::vector<double> distances;
+    corres.reserve(static_cast<size_t>(num_src_pts) * knn);
+    distances.reserve(static_cast<size_t>(num_src_pts) * knn);
+    for (int i = 0; i < num_src_pts; i++) {
+        const size_t offset = static_cast<size_t>(i) * num_neighbors;
+        const double reference2 =
+                ratio_test ? ratio2 * nn_distance2[offset + knn]
+                           : std::numeric_limits<double>::infinity();
+        for (int m = 0; m < knn; m++) {
+            const int j = nn_indices[offset + m];
+            // Neighbors are sorted, the remaining ones fail as well.
+            if (j < 0 || !(nn_distance2[offset + m] < reference2)) {
+                break;
+            }
+            corres.emplace_back(i, j);
+            distances.push_back(std::sqrt(nn_distance2[offset + m]));
+        }
+    }
+    utility::LogDebug("{:d} candidate correspondences for {:d} features.",
+                      static_cast<int>(corres.size()), num_src_pts);
+    return std::make_tuple(std::move(corres), std::move(distances));
+}
+
+std::vector<double> ComputeCorrespondenceFeatureDistances(
+        const Feature &source_features,
+        const Feature &target_features,
+        const CorrespondenceSet &corres) {
+    if (source_features.Dimension() != target_features.Dimension()) {
+        utility::LogError(
+                "Feature dimensions do not match, got {:d} and {:d}.",
+                static_cast<int>(source_features.Dimension()),
+                static_cast<int>(target_features.Dimension()));
+    }
+    std::vector<double> distances(corres.size());
+#pragma omp parallel for schedule(static) \
+        num_threads(utility::EstimateMaxThreads())
+    for (int i = 0; i < static_cast<int>(corres.size()); i++) {
+        const int s = corres[i](0);
+        const int t = corres[i](1);
+        if (s < 0 || s >= static_cast<int>(source_features.Num()) || t < 0 ||
+            t >= static_cast<int>(target_features.Num())) {
+            distances[i] = std::numeric_limits<double>::infinity();
+            continue;
+        }
+        distances[i] = (source_features.data_.col(s) -
+                        target_features.data_.col(t))
+                               .norm();
+    }
+    return distances;
+}
+
 }  // namespace registration
 }  // namespace pipelines
 }  // namespace tiny3d
@@ -9,6 +9,7 @@
 
 #include <Eigen/Core>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 #include "tiny3d/geometry/KDTreeSearchParam.h"
@@ -59,13 +60,75 @@ public:
 ///
 /// \param input The Input point cloud.
 /// \param search_param KDTree KNN search parameter.
-/// \param indices Indices of the points to compute FPFH features on.
-/// If not set, compute features for the whole point cloud.
 std::shared_ptr<Feature> ComputeFPFHFeature(
         const geometry::PointCloud &input,
         const geometry::KDTreeSearchParam &search_param =
                 geometry::KDTreeSearchParamKNN());
 
+/// Function to compute FPFH feature for a subset of the points of a point
+/// cloud, e.g. keypoints. Neighborhoods are taken from the whole point cloud,
+/// but SPFH histograms are only computed for the selected points and their
+/// neighbors, so the features equal the corresponding columns of the features
+/// of the whole point cloud at a fraction of the cost.
+///
+/// \param input The Input point cloud.
+/// \param search_param KDTree KNN search parameter.
+/// \param indices Indices of the points to compute FPFH features on. Column i
+/// of the result is the feature of point indices[i].
+std::shared_ptr<Feature> ComputeFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::KDTreeSearchParam &search_param,
+        const std::vector<size_t> &indices);
+
+/// \enum FeatureMatchingMethod
+///
+/// \brief Nearest neighbor search used to match features.
+enum class FeatureMatchingMethod {
+    /// Exact search with a KD-tree (KDTreeFlann).
+    KDTree = 0,
+    /// Approximate search with a randomized KD-tree forest (KDTreeForest),
+    /// which is much faster on large sets of high dimensional features.
+    KDTreeForest = 1,
+    /// Brute force search, computed in cache sized tiles of single precision
+    /// dot products as |q|^2 + |d|^2 - 2 q.d. It is exact up to single
+    /// precision rounding: neighbors at nearly equal distances may be ordered
+    /// differently than by KDTree. Its cost is quadratic in the number of
+    /// features, so it only pays off for features of high intrinsic
+    /// dimension, where the KD-tree degenerates. On FPFH features the KD-tree
+    /// is faster, unless the kernel is compiled for AVX-512 with the
+    /// FEATURE_MATCHING_ISA build option, which brings them close.
+    BruteForce = 2,
+};
+
+/// \class FeatureMatchingOption
+///
+/// \brief Options of the nearest neighbor search used for feature matching.
+class FeatureMatchingOption {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param method Nearest neighbor search method.
+    /// \param num_trees Number of randomized trees of the KDTreeForest method.
+    /// \param max_checks Maximum number of distance evaluations per query of
+    /// the KDTreeForest method. Larger values increase the recall at the cost
+    /// of speed.
+    FeatureMatchingOption(
+            FeatureMatchingMethod method = FeatureMatchingMethod::KDTree,
+            int num_trees = 4,
+            int max_checks = 128)
+        : method_(method), num_trees_(num_trees), max_checks_(max_checks) {}
+    ~FeatureMatchingOption() {}
+
+public:
+    /// Nearest neighbor search method.
+    FeatureMatchingMethod method_;
+    /// Number of randomized trees of the KDTreeForest method.
+    int num_trees_;
+    /// Maximum number of distance evaluations per query of the KDTreeForest
+    /// method.
+    int max_checks_;
+};
+
 /// \brief Function to find correspondences via 1-nearest neighbor feature
 /// matching. Target is used to construct a nearest neighbor search
 /// object, in order to query source.
@@ -82,11 +145,54 @@ std::shared_ptr<Feature> ComputeFPFHFeature(
 /// of the aforementioned correspondence set where source[i] and target[j] are
 /// mutually the nearest neighbor. If the subset size is smaller than
 /// mutual_consistency_ratio * N, return the unfiltered set.
+/// \param option Nearest neighbor search options, selects between exact and
+/// approximate matching.
 CorrespondenceSet CorrespondencesFromFeatures(
         const Feature &source_features,
         const Feature &target_features,
         bool mutual_filter = false,
-        float mutual_consistency_ratio = 0.1);
+        float mutual_consistency_ratio = 0.1,
+        const FeatureMatchingOption &option = FeatureMatchingOption());
+
+/// \brief Function to find the k nearest neighbor candidates of every source
+/// feature among the target features, optionally filtered by Lowe's ratio
+/// test.
+///
+/// The ratio test keeps a candidate only if its feature distance is below
+/// \p ratio_threshold times the distance of the (knn + 1)-th nearest
+/// neighbor; for knn = 1 this is the ratio of the nearest to the second
+/// nearest neighbor. Ambiguous features, e.g. on repetitive or flat
+/// structures, then contribute no correspondence, which leaves fewer outliers
+/// for RANSAC.
+/// \param source_features (D, N) feature
+/// \param target_features (D, M) feature
+/// \param knn Number of candidates per source feature.
+/// \param ratio_threshold Ratio test threshold in (0, 1). Values of 1 or
+/// larger disable the test.
+/// \param option Nearest neighbor search options.
+/// \return A CorrespondenceSet grouped by source index, with the candidates
+/// of every source feature sorted by increasing feature distance, and the
+/// Euclidean feature distance of every correspondence.
+std::tuple<CorrespondenceSet, std::vector<double>>
+CorrespondencesFromFeaturesKNN(
+        const Feature &source_features,
+        const Feature &target_features,
+        int knn = 1,
+        double ratio_threshold = 1.0,
+        const FeatureMatchingOption &option = FeatureMatchingOption());
+
+/// \brief Function to compute the feature space distance of correspondences.
+/// The distance can be used as a quality score of the correspondences, a
+/// smaller distance indicates a more distinctive match.
+/// \param source_features (D, N) feature
+/// \param target_features (D, M) feature
+/// \param corres Correspondences between source and target features.
+/// \return The Euclidean distance between the features of every
+/// correspondence, in the order of \p corres.
+std::vector<double> ComputeCorrespondenceFeatureDistances(
+        const Feature &source_features,
+        const Feature &target_features,
+        const CorrespondenceSet &corres);
 
 }  // namespace registration
 }  // namespace pipelines
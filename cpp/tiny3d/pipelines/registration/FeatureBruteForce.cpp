@@ -0,0 +1,190 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/pipelines/registration/FeatureBruteForce.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "tiny3d/utility/Parallel.h"
+
+namespace tiny3d {
+namespace pipelines {
+namespace registration {
+namespace brute_force {
+
+namespace {
+
+/// Data features per step of the micro kernel, two vector registers of
+/// floats, so that the kQueryGroup x kLanes accumulators fill most registers
+/// and hide the latency of the multiply-adds.
+#if defined(__AVX512F__)
+constexpr int kLanes = 32;
+#elif defined(__AVX__)
+constexpr int kLanes = 16;
+#else
+constexpr int kLanes = 8;
+#endif
+/// Queries per step of the micro kernel, which share the loads of the data.
+constexpr int kQueryGroup = 6;
+/// Data features per tile; the transposed tile of FPFH features fits in the
+/// L1 cache.
+constexpr int kDataBlock = 256;
+/// Queries per task of the parallel loop.
+constexpr int kQueryBlock = 64;
+/// Distances per chunk of the neighbor selection.
+constexpr int kSelectChunk = 64;
+
+/// Computes |d|^2 - 2 q.d for the kQueryGroup queries at \p query and the
+/// data features [d_begin, d_end) of \p data_t, which stores the features
+/// transposed: coordinate k of feature j is at data_t[k * stride + j].
+/// Row q of \p tile receives the values of query q. The accumulators are
+/// kept in registers, and every data load feeds kQueryGroup multiply-adds.
+void ComputeTile(const float *const query[kQueryGroup],
+                 const float *data_t,
+                 const float *data_norm2,
+                 size_t stride,
+                 int dimension,
+                 int d_begin,
+                 int d_end,
+                 float *tile) {
+    for (int j = d_begin; j < d_end; j += kLanes) {
+        float acc[kQueryGroup][kLanes] = {};
+        for (int k = 0; k < dimension; k++) {
+            const float *d = data_t + k * stride + j;
+            for (int q = 0; q < kQueryGroup; q++) {
+                const float value = query[q][k];
+#pragma omp simd
+                for (int l = 0; l < kLanes; l++) {
+                    acc[q][l] += value * d[l];
+                }
+            }
+        }
+        for (int q = 0; q < kQueryGroup; q++) {
+            float *row = tile + q * kDataBlock + (j - d_begin);
+#pragma omp simd
+            for (int l = 0; l < kLanes; l++) {
+                row[l] = data_norm2[j + l] - 2.0f * acc[q][l];
+            }
+        }
+    }
+}
+
+}  // namespace
+
+void SearchKNN(const float *queries,
+               int num_queries,
+               const float *data,
+               int num_data,
+               int dimension,
+               int knn,
+               std::vector<int> &indices,
+               std::vector<float> &distance2) {
+    indices.assign(static_cast<size_t>(num_queries) * knn, -1);
+    distance2.assign(static_cast<size_t>(num_queries) * knn,
+                     std::numeric_limits<float>::infinity());
+    if (num_queries == 0 || num_data == 0) {
+        return;
+    }
+
+    // Transposed data, padded with zeros to a multiple of kLanes features.
+    const size_t stride =
+            (static_cast<size_t>(num_data) + kLanes - 1) / kLanes * kLanes;
+    std::vector<float> data_t(stride * dimension, 0.0f);
+    std::vector<float> data_norm2(stride, 0.0f);
+    for (int j = 0; j < num_data; j++) {
+        const float *feature = data + static_cast<size_t>(j) * dimension;
+        float norm2 = 0.0f;
+        for (int k = 0; k < dimension; k++) {
+            data_t[k * stride + j] = feature[k];
+            norm2 += feature[k] * feature[k];
+        }
+        data_norm2[j] = norm2;
+    }
+    const int num_query_blocks = (num_queries + kQueryBlock - 1) / kQueryBlock;
+
+#pragma omp parallel num_threads(utility::EstimateMaxThreads())
+    {
+        std::vector<float> tile(kQueryGroup * kDataBlock);
+#pragma omp for schedule(dynamic, 1)
+        for (int qb = 0; qb < num_query_blocks; qb++) {
+            const int q_begin = qb * kQueryBlock;
+            const int q_end = std::min(q_begin + kQueryBlock, num_queries);
+            for (int d_begin = 0; d_begin < num_data; d_begin += kDataBlock) {
+                const int d_end = std::min(d_begin + kDataBlock, num_data);
+                const int d_end_padded = static_cast<int>(std::min<size_t>(
+                        d_begin + kDataBlock, stride));
+                for (int g = q_begin; g < q_end; g += kQueryGroup) {
+                    // A partial group repeats its last query.
+                    const float *query[kQueryGroup];
+                    for (int q = 0; q < kQueryGroup; q++) {
+                        query[q] = queries + static_cast<size_t>(std::min(
+                                                     g + q, q_end - 1)) *
+                                                     dimension;
+                    }
+                    ComputeTile(query, data_t.data(), data_norm2.data(),
+                                stride, dimension, d_begin, d_end_padded,
+                                tile.data());
+                    for (int q = 0; q < kQueryGroup && g + q < q_end; q++) {
+                        float query_norm2 = 0.0f;
+                        for (int k = 0; k < dimension; k++) {
+                            query_norm2 += query[q][k] * query[q][k];
+                        }
+                        const float *row = tile.data() + q * kDataBlock;
+                        int *best_indices =
+                                &indices[static_cast<size_t>(g + q) * knn];
+                        float *best_distance2 =
+                                &distance2[static_cast<size_t>(g + q) * knn];
+                        for (int c_begin = d_begin; c_begin < d_end;
+                             c_begin += kSelectChunk) {
+                            const int c_end =
+                                    std::min(c_begin + kSelectChunk, d_end);
+                            // Most chunks hold no neighbor; their minimum
+                            // skips them. Adding the norm is monotone, so
+                            // the test is exact.
+                            float chunk_min =
+                                    std::numeric_limits<float>::infinity();
+#pragma omp simd reduction(min : chunk_min)
+                            for (int j = c_begin; j < c_end; j++) {
+                                const float value = row[j - d_begin];
+                                chunk_min =
+                                        value < chunk_min ? value : chunk_min;
+                            }
+                            if (!(std::max(chunk_min + query_norm2, 0.0f) <
+                                  best_distance2[knn - 1])) {
+                                continue;
+                            }
+                            for (int j = c_begin; j < c_end; j++) {
+                                const float d2 = std::max(
+                                        row[j - d_begin] + query_norm2, 0.0f);
+                                if (!(d2 < best_distance2[knn - 1])) {
+                                    continue;
+                                }
+                                // Insert in the sorted neighbor list.
+                                int pos = knn - 1;
+                                while (pos > 0 &&
+                                       d2 < best_distance2[pos - 1]) {
+                                    best_distance2[pos] =
+                                            best_distance2[pos - 1];
+                                    best_indices[pos] = best_indices[pos - 1];
+                                    pos--;
+                                }
+                                best_distance2[pos] = d2;
+                                best_indices[pos] = j;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace brute_force
+}  // namespace registration
+}  // namespace pipelines
+}  // namespace tiny3d
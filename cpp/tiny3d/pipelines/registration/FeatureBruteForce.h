@@ -0,0 +1,42 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vector>
+
+namespace tiny3d {
+namespace pipelines {
+namespace registration {
+namespace brute_force {
+
+/// K nearest neighbors of the \p num_queries features at \p queries among the
+/// \p num_data features at \p data by brute force in single precision. Both
+/// store \p dimension floats per feature, one feature after the other.
+/// Squared distances are expanded as |q|^2 + |d|^2 - 2 q.d; the result is
+/// exact up to single precision rounding, which may reorder neighbors at
+/// nearly equal distances. Ties are resolved towards the lower data index, so
+/// the result does not depend on the number of threads. Neighbors of query i
+/// are stored sorted at [i * knn, (i + 1) * knn), missing ones with index -1
+/// and infinite squared distance.
+///
+/// The kernel is compiled for the instruction set selected by the
+/// FEATURE_MATCHING_ISA build option, and does not use Eigen, whose memory
+/// alignment depends on the instruction set.
+void SearchKNN(const float *queries,
+               int num_queries,
+               const float *data,
+               int num_data,
+               int dimension,
+               int knn,
+               std::vector<int> &indices,
+               std::vector<float> &distance2);
+
+}  // namespace brute_force
+}  // namespace registration
+}  // namespace pipelines
+}  // namespace tiny3d
@@ -0,0 +1,688 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/pipelines/registration/MaxCliqueRegistration.h"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "tiny3d/geometry/PointCloud.h"
+#include "tiny3d/pipelines/registration/Feature.h"
+#include "tiny3d/utility/Logging.h"
+#include "tiny3d/utility/Parallel.h"
+
+namespace tiny3d {
+namespace pipelines {
+namespace registration {
+
+namespace {
+
+/// Truncated least squares estimate of a scalar from \p values, where value k
+/// is an inlier if it lies within \p bounds[k] of the estimate. The estimate
+/// minimizes sum_k min((x - values[k])^2 / bounds[k]^2, 1) by adaptive voting
+/// over the consensus sets of the intervals [values[k] +- bounds[k]].
+double EstimateScalarTLS(const std::vector<double> &values,
+                         const std::vector<double> &bounds) {
+    const int n = static_cast<int>(values.size());
+    // (position, index), with entering boundaries ordered before leaving ones.
+    std::vector<std::pair<double, int>> boundaries;
+    boundaries.reserve(2 * n);
+    for (int k = 0; k < n; k++) {
+        boundaries.emplace_back(values[k] - bounds[k], k);
+        boundaries.emplace_back(values[k] + bounds[k], k + n);
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+
+    double sum_w = 0.0, sum_wx = 0.0, sum_wxx = 0.0;
+    int num_inliers = 0;
+    double best_estimate = n > 0 ? values[0] : 0.0;
+    double best_cost = std::numeric_limits<double>::infinity();
+    for (const auto &boundary : boundaries) {
+        const bool entering = boundary.second < n;
+        const int k = entering ? boundary.second : boundary.second - n;
+        const double w = 1.0 / (bounds[k] * bounds[k]);
+        const double sign = entering ? 1.0 : -1.0;
+        sum_w += sign * w;
+        sum_wx += sign * w * values[k];
+        sum_wxx += sign * w * values[k] * values[k];
+        num_inliers += entering ? 1 : -1;
+        if (!entering || sum_w <= 0.0) {
+            continue;
+        }
+        const double estimate = sum_wx / sum_w;
+        const double cost = std::max(0.0, sum_wxx - sum_wx * estimate) +
+                            (n - num_inliers);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_estimate = estimate;
+        }
+    }
+    return best_estimate;
+}
+
+/// Index of the lowest set bit of a non-zero \p word.
+inline int LowestSetBit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+/// Returns at most \p max_size indices of [0, n) spread evenly over the range.
+std::vector<int> StridedSubset(int n, int max_size) {
+    std::vector<int> subset;
+    if (n <= max_size) {
+        subset.resize(n);
+        std::iota(subset.begin(), subset.end(), 0);
+        return subset;
+    }
+    subset.reserve(max_size);
+    for (int k = 0; k < max_size; k++) {
+        subset.push_back(static_cast<int>(static_cast<int64_t>(k) * n /
+                                          max_size));
+    }
+    return subset;
+}
+
+/// \class MaxCliqueSolver
+///
+/// Maximum clique solver for sparse undirected graphs, following the parallel
+/// branch and bound of PMC (Rossi et al., "Parallel Maximum Clique Algorithms
+/// with Applications to Network Analysis", SISC 2015). Vertices are searched
+/// in degeneracy order and pruned by their core numbers; the neighborhood of
+/// every vertex is searched with bitsets and greedy coloring bounds.
+class MaxCliqueSolver {
+public:
+    /// \p adjacency holds the sorted neighbor lists of the graph.
+    explicit MaxCliqueSolver(const std::vector<std::vector<int>> &adjacency)
+        : adjacency_(adjacency) {
+        ComputeCoreNumbers();
+    }
+
+    /// Returns the vertices of a maximum clique. With \p exact set to false,
+    /// or once \p time_limit seconds have passed, the largest clique found so
+    /// far is returned.
+    std::vector<int> Solve(bool exact, double time_limit);
+
+private:
+    void ComputeCoreNumbers();
+    bool IsAdjacent(int u, int v) const {
+        return std::binary_search(adjacency_[u].begin(), adjacency_[u].end(),
+                                  v);
+    }
+    std::vector<int> GreedyClique(int v, int min_core) const;
+    void SearchNeighborhood(int v, std::vector<int> &local_index);
+    void Expand(std::vector<uint64_t> &candidates,
+                std::vector<int> &clique,
+                const std::vector<uint64_t> &local_adjacency,
+                int num_words,
+                int v,
+                const std::vector<int> &neighbors);
+    void UpdateBest(int v,
+                    const std::vector<int> &clique,
+                    const std::vector<int> &neighbors);
+
+private:
+    const std::vector<std::vector<int>> &adjacency_;
+    /// Core number of every vertex.
+    std::vector<int> core_;
+    /// Vertices in degeneracy order, and the position of every vertex in it.
+    std::vector<int> order_;
+    std::vector<int> position_;
+
+    std::vector<int> best_clique_;
+    std::atomic<int> best_size_{0};
+    std::atomic<bool> timed_out_{false};
+    std::chrono::steady_clock::time_point deadline_;
+};
+
+void MaxCliqueSolver::ComputeCoreNumbers() {
+    // Batagelj and Zaversnik, "An O(m) Algorithm for Cores Decomposition of
+    // Networks", 2003.
+    const int n = static_cast<int>(adjacency_.size());
+    core_.resize(n);
+    order_.resize(n);
+    position_.resize(n);
+    int max_degree = 0;
+    for (int v = 0; v < n; v++) {
+        core_[v] = static_cast<int>(adjacency_[v].size());
+        max_degree = std::max(max_degree, core_[v]);
+    }
+    std::vector<int> bin(max_degree + 1, 0);
+    for (int v = 0; v < n; v++) {
+        bin[core_[v]]++;
+    }
+    int start = 0;
+    for (int d = 0; d <= max_degree; d++) {
+        const int count = bin[d];
+        bin[d] = start;
+        start += count;
+    }
+    for (int v = 0; v < n; v++) {
+        position_[v] = bin[core_[v]]++;
+        order_[position_[v]] = v;
+    }
+    for (int d = max_degree; d > 0; d--) {
+        bin[d] = bin[d - 1];
+    }
+    bin[0] = 0;
+    for (int i = 0; i < n; i++) {
+        const int v = order_[i];
+        for (int u : adjacency_[v]) {
+            if (core_[u] > core_[v]) {
+                const int du = core_[u];
+                const int pu = position_[u];
+                const int pw = bin[du];
+                const int w = order_[pw];
+                if (u != w) {
+                    position_[u] = pw;
+                    order_[pu] = w;
+                    position_[w] = pu;
+                    order_[pw] = u;
+                }
+                bin[du]++;
+                core_[u]--;
+            }
+        }
+    }
+}
+
+std::vector<int> MaxCliqueSolver::GreedyClique(int v, int min_core) const {
+    std::vector<int> candidates;
+    for (int u : adjacency_[v]) {
+        if (core_[u] >= min_core) {
+            candidates.push_back(u);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+        return core_[a] > core_[b] || (core_[a] == core_[b] && a < b);
+    });
+    std::vector<int> clique{v};
+    for (int u : candidates) {
+        bool adjacent = true;
+        for (int w : clique) {
+            if (w != v && !IsAdjacent(u, w)) {
+                adjacent = false;
+                break;
+            }
+        }
+        if (adjacent) {
+            clique.push_back(u);
+        }
+    }
+    return clique;
+}
+
+std::vector<int> MaxCliqueSolver::Solve(bool exact, double time_limit) {
+    const int n = static_cast<int>(adjacency_.size());
+    best_clique_.clear();
+    best_size_ = 0;
+    timed_out_ = false;
+    if (n == 0) {
+        return best_clique_;
+    }
+    best_clique_ = {order_[n - 1]};
+    best_size_ = 1;
+
+    // Greedy lower bound, seeded from every vertex that could improve it.
+#pragma omp parallel for schedule(dynamic, 16) \
+        num_threads(utility::EstimateMaxThreads())
+    for (int i = n - 1; i >= 0; i--) {
+        const int v = order_[i];
+        const int best_size = best_size_.load(std::memory_order_relaxed);
+        if (core_[v] + 1 <= best_size) {
+            continue;
+        }
+        std::vector<int> clique = GreedyClique(v, best_size);
+        if (static_cast<int>(clique.size()) > best_size) {
+#pragma omp critical(MaxCliqueSolverUpdateBest)
+            {
+                if (static_cast<int>(clique.size()) > best_size_.load()) {
+                    best_clique_ = std::move(clique);
+                    best_size_ = static_cast<int>(best_clique_.size());
+                }
+            }
+        }
+    }
+    if (!exact) {
+        return best_clique_;
+    }
+
+    deadline_ = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(time_limit));
+#pragma omp parallel num_threads(utility::EstimateMaxThreads())
+    {
+        std::vector<int> local_index(n, -1);
+        // Vertices of the highest cores first, where large cliques are found.
+#pragma omp for schedule(dynamic, 1)
+        for (int i = n - 1; i >= 0; i--) {
+            if (timed_out_.load(std::memory_order_relaxed)) {
+                continue;
+            }
+            const int v = order_[i];
+            if (core_[v] + 1 <= best_size_.load(std::memory_order_relaxed)) {
+                continue;
+            }
+            SearchNeighborhood(v, local_index);
+        }
+    }
+    if (timed_out_) {
+        utility::LogDebug(
+                "Maximum clique search hit the time limit, using a clique of "
+                "size {:d}.",
+                best_size_.load());
+    }
+    return best_clique_;
+}
+
+void MaxCliqueSolver::SearchNeighborhood(int v, std::vector<int> &local_index) {
+    // Only cliques whose first vertex in degeneracy order is v are searched;
+    // every member of a clique larger than the best has a large enough core.
+    const int best_size = best_size_.load(std::memory_order_relaxed);
+    std::vector<int> neighbors;
+    for (int u : adjacency_[v]) {
+        if (position_[u] > position_[v] && core_[u] >= best_size) {
+            neighbors.push_back(u);
+        }
+    }
+    const int m = static_cast<int>(neighbors.size());
+    if (m + 1 <= best_size) {
+        return;
+    }
+
+    const int num_words = (m + 63) / 64;
+    std::vector<uint64_t> local_adjacency(static_cast<size_t>(m) * num_words,
+                                          0);
+    for (int a = 0; a < m; a++) {
+        local_index[neighbors[a]] = a;
+    }
+    for (int a = 0; a < m; a++) {
+        uint64_t *row = local_adjacency.data() + static_cast<size_t>(a) *
+                                                         num_words;
+        for (int w : adjacency_[neighbors[a]]) {
+            const int b = local_index[w];
+            if (b >= 0) {
+                row[b / 64] |= uint64_t(1) << (b % 64);
+            }
+        }
+    }
+    for (int a = 0; a < m; a++) {
+        local_index[neighbors[a]] = -1;
+    }
+
+    std::vector<uint64_t> candidates(num_words, ~uint64_t(0));
+    if (m % 64 != 0) {
+        candidates.back() = (uint64_t(1) << (m % 64)) - 1;
+    }
+    std::vector<int> clique;
+    Expand(candidates, clique, local_adjacency, num_words, v, neighbors);
+}
+
+void MaxCliqueSolver::Expand(std::vector<uint64_t> &candidates,
+                             std::vector<int> &clique,
+                             const std::vector<uint64_t> &local_adjacency,
+                             int num_words,
+                             int v,
+                             const std::vector<int> &neighbors) {
+    if (timed_out_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (std::chrono::steady_clock::now() > deadline_) {
+        timed_out_ = true;
+        return;
+    }
+
+    // Greedy coloring: vertices of one color class are pairwise
+    // non-adjacent, so a clique takes at most one vertex per color.
+    std::vector<int> vertices;
+    std::vector<int> colors;
+    std::vector<uint64_t> uncolored = candidates;
+    std::vector<uint64_t> color_class(num_words);
+    int color = 0;
+    auto any = [num_words](const std::vector<uint64_t> &bits) {
+        for (int w = 0; w < num_words; w++) {
+            if (bits[w] != 0) return true;
+        }
+        return false;
+    };
+    while (any(uncolored)) {
+        color++;
+        color_class = uncolored;
+        for (int w = 0; w < num_words; w++) {
+            while (color_class[w] != 0) {
+                const int b = w * 64 + LowestSetBit(color_class[w]);
+                const uint64_t bit = uint64_t(1) << (b % 64);
+                color_class[w] &= ~bit;
+                uncolored[w] &= ~bit;
+                const uint64_t *row = local_adjacency.data() +
+                                      static_cast<size_t>(b) * num_words;
+                for (int x = w; x < num_words; x++) {
+                    color_class[x] &= ~row[x];
+                }
+                vertices.push_back(b);
+                colors.push_back(color);
+            }
+        }
+    }
+
+    std::vector<uint64_t> next(num_words);
+    for (int k = static_cast<int>(vertices.size()) - 1; k >= 0; k--) {
+        if (static_cast<int>(clique.size()) + 1 + colors[k] <=
+            best_size_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        const int b = vertices[k];
+        const uint64_t *row =
+                local_adjacency.data() + static_cast<size_t>(b) * num_words;
+        for (int w = 0; w < num_words; w++) {
+            next[w] = candidates[w] & row[w];
+        }
+        clique.push_back(b);
+        if (any(next)) {
+            Expand(next, clique, local_adjacency, num_words, v, neighbors);
+        } else if (static_cast<int>(clique.size()) + 1 >
+                   best_size_.load(std::memory_order_relaxed)) {
+            UpdateBest(v, clique, neighbors);
+        }
+        clique.pop_back();
+        candidates[b / 64] &= ~(uint64_t(1) << (b % 64));
+    }
+}
+
+void MaxCliqueSolver::UpdateBest(int v,
+                                 const std::vector<int> &clique,
+                                 const std::vector<int> &neighbors) {
+#pragma omp critical(MaxCliqueSolverUpdateBest)
+    {
+        if (static_cast<int>(clique.size()) + 1 > best_size_.load()) {
+            best_clique_.clear();
+            best_clique_.push_back(v);
+            for (int b : clique) {
+                best_clique_.push_back(neighbors[b]);
+            }
+            best_size_ = static_cast<int>(best_clique_.size());
+        }
+    }
+}
+
+/// Rotation that maps \p source onto \p target in the weighted least squares
+/// sense (Horn, Kabsch).
+Eigen::Matrix3d EstimateWeightedRotation(
+        const std::vector<Eigen::Vector3d> &source,
+        const std::vector<Eigen::Vector3d> &target,
+        const std::vector<double> &weights) {
+    Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+    for (size_t k = 0; k < source.size(); k++) {
+        covariance.noalias() += weights[k] * source[k] * target[k].transpose();
+    }
+    Eigen::JacobiSVD<Eigen::Matrix3d> svd(
+            covariance, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    Eigen::Matrix3d correction = Eigen::Matrix3d::Identity();
+    correction(2, 2) = (svd.matrixV() * svd.matrixU().transpose()).determinant();
+    return svd.matrixV() * correction * svd.matrixU().transpose();
+}
+
+/// Robust rotation estimation with graduated non-convexity and a truncated
+/// least squares cost (Yang et al., "Graduated Non-Convexity for Robust
+/// Spatial Perception", RA-L 2020). Residuals above \p noise_bound are
+/// treated as outliers.
+Eigen::Matrix3d EstimateRotationGNCTLS(
+        const std::vector<Eigen::Vector3d> &source,
+        const std::vector<Eigen::Vector3d> &target,
+        double noise_bound,
+        const MaxCliqueRegistrationOption &option) {
+    const int n = static_cast<int>(source.size());
+    const double noise_bound2 = noise_bound * noise_bound;
+    std::vector<double> weights(n, 1.0);
+    std::vector<double> residuals2(n);
+    Eigen::Matrix3d rotation =
+            EstimateWeightedRotation(source, target, weights);
+
+    auto compute_residuals = [&]() {
+        double max_residual2 = 0.0;
+        for (int k = 0; k < n; k++) {
+            residuals2[k] = (target[k] - rotation * source[k]).squaredNorm();
+            max_residual2 = std::max(max_residual2, residuals2[k]);
+        }
+        return max_residual2;
+    };
+    double mu = 1.0 / (2.0 * compute_residuals() / noise_bound2 - 1.0);
+    if (mu <= 0.0) {
+        // All residuals are within the noise bound.
+        return rotation;
+    }
+
+    double prev_cost = std::numeric_limits<double>::infinity();
+    for (int itr = 0; itr < option.rotation_max_iteration_; itr++) {
+        if (itr > 0) {
+            compute_residuals();
+        }
+        const double upper = (mu + 1.0) / mu * noise_bound2;
+        const double lower = mu / (mu + 1.0) * noise_bound2;
+        double cost = 0.0;
+        for (int k = 0; k < n; k++) {
+            if (residuals2[k] >= upper) {
+                weights[k] = 0.0;
+            } else if (residuals2[k] <= lower) {
+                weights[k] = 1.0;
+            } else {
+                weights[k] = std::sqrt(noise_bound2 * mu * (mu + 1.0) /
+                                       residuals2[k]) -
+                             mu;
+            }
+            cost += weights[k] * residuals2[k];
+        }
+        rotation = EstimateWeightedRotation(source, target, weights);
+        if (std::abs(cost - prev_cost) < option.rotation_cost_threshold_) {
+            break;
+        }
+        prev_cost = cost;
+        mu *= option.rotation_gnc_factor_;
+    }
+    return rotation;
+}
+
+}  // namespace
+
+RegistrationResult RegistrationMaxCliqueBasedOnCorrespondence(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres,
+        double max_correspondence_distance,
+        const MaxCliqueRegistrationOption &option
+        /* = MaxCliqueRegistrationOption()*/) {
+    if (corres.size() < 3 || max_correspondence_distance <= 0.0) {
+        return RegistrationResult();
+    }
+    if (source.IsEmpty() || target.IsEmpty()) {
+        return RegistrationResult();
+    }
+
+    // The consistency graph is quadratic in the number of correspondences.
+    // Without a quality order to rank them by, a strided subset bounds it.
+    const int max_size = option.max_num_correspondences_ > 0
+                                 ? option.max_num_correspondences_
+                                 : static_cast<int>(corres.size());
+    const std::vector<int> kept =
+            StridedSubset(static_cast<int>(corres.size()), max_size);
+    const int n = static_cast<int>(kept.size());
+    if (n < 3) {
+        return RegistrationResult();
+    }
+    std::vector<Eigen::Vector3d> source_points(n), target_points(n);
+    for (int k = 0; k < n; k++) {
+        source_points[k] = source.points_[corres[kept[k]](0)];
+        target_points[k] = target.points_[corres[kept[k]](1)];
+    }
+    // Pairwise distances of inliers differ by at most twice the noise bound.
+    const double pair_bound = 2.0 * max_correspondence_distance;
+
+    // Scale: adaptive voting over the ratios of pairwise distances. Pairs are
+    // taken among a bounded subset of the correspondences.
+    double scale = 1.0;
+    if (option.with_scaling_) {
+        constexpr int kMaxScaleCorrespondences = 1000;
+        const std::vector<int> subset =
+                StridedSubset(n, kMaxScaleCorrespondences);
+        std::vector<double> ratios, bounds;
+        for (size_t a = 0; a < subset.size(); a++) {
+            for (size_t b = a + 1; b < subset.size(); b++) {
+                const double source_length =
+                        (source_points[subset[a]] - source_points[subset[b]])
+                                .norm();
+                if (source_length <= pair_bound) {
+                    continue;
+                }
+                const double target_length =
+                        (target_points[subset[a]] - target_points[subset[b]])
+                                .norm();
+                ratios.push_back(target_length / source_length);
+                bounds.push_back(pair_bound / source_length);
+            }
+        }
+        if (ratios.empty()) {
+            return RegistrationResult();
+        }
+        scale = EstimateScalarTLS(ratios, bounds);
+        if (!(scale > 0.0)) {
+            return RegistrationResult();
+        }
+    }
+
+    // Consistency graph: correspondences are connected if their pairwise
+    // distances agree up to the noise bound.
+    std::vector<std::vector<int>> upper_neighbors(n);
+#pragma omp parallel for schedule(dynamic, 16) \
+        num_threads(utility::EstimateMaxThreads())
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            const double source_length =
+                    (source_points[i] - source_points[j]).norm();
+            const double target_length =
+                    (target_points[i] - target_points[j]).norm();
+            if (std::abs(scale * source_length - target_length) <=
+                pair_bound) {
+                upper_neighbors[i].push_back(j);
+            }
+        }
+    }
+    std::vector<std::vector<int>> adjacency(n);
+    for (int i = 0; i < n; i++) {
+        for (int j : upper_neighbors[i]) {
+            adjacency[i].push_back(j);
+            adjacency[j].push_back(i);
+        }
+        std::vector<int>().swap(upper_neighbors[i]);
+    }
+
+    MaxCliqueSolver solver(adjacency);
+    std::vector<int> clique =
+            solver.Solve(option.exact_max_clique_, option.max_clique_time_limit_);
+    utility::LogDebug("Maximum clique has {:d} of {:d} correspondences.",
+                      static_cast<int>(clique.size()), n);
+    if (clique.size() < 3) {
+        return RegistrationResult();
+    }
+    std::sort(clique.begin(), clique.end());
+
+    // Rotation from translation invariant measurements, the differences of
+    // pairs of clique members, again among a bounded subset.
+    constexpr int kMaxRotationCorrespondences = 1000;
+    const std::vector<int> subset = StridedSubset(
+            static_cast<int>(clique.size()), kMaxRotationCorrespondences);
+    std::vector<Eigen::Vector3d> source_tims, target_tims;
+    for (size_t a = 0; a < subset.size(); a++) {
+        for (size_t b = a + 1; b < subset.size(); b++) {
+            const int i = clique[subset[a]];
+            const int j = clique[subset[b]];
+            source_tims.push_back(scale *
+                                  (source_points[j] - source_points[i]));
+            target_tims.push_back(target_points[j] - target_points[i]);
+        }
+    }
+    const Eigen::Matrix3d rotation = EstimateRotationGNCTLS(
+            source_tims, target_tims, pair_bound, option);
+
+    // Translation: component-wise adaptive voting over the clique members.
+    Eigen::Vector3d translation;
+    std::vector<double> values(clique.size());
+    const std::vector<double> bounds(clique.size(),
+                                     max_correspondence_distance);
+    for (int axis = 0; axis < 3; axis++) {
+        for (size_t k = 0; k < clique.size(); k++) {
+            const int i = clique[k];
+            values[k] = (target_points[i] -
+                         scale * rotation * source_points[i])(axis);
+        }
+        translation(axis) = EstimateScalarTLS(values, bounds);
+    }
+
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) = scale * rotation;
+    transformation.block<3, 1>(0, 3) = translation;
+    return EvaluateRegistration(source, target, max_correspondence_distance,
+                                transformation);
+}
+
+RegistrationResult RegistrationMaxCliqueBasedOnFeatureMatching(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const Feature &source_features,
+        const Feature &target_features,
+        bool mutual_filter,
+        double max_correspondence_distance,
+        const MaxCliqueRegistrationOption &option
+        /* = MaxCliqueRegistrationOption()*/) {
+    if (max_correspondence_distance <= 0.0) {
+        return RegistrationResult();
+    }
+
+    CorrespondenceSet corres = CorrespondencesFromFeatures(
+            source_features, target_features, mutual_filter);
+    if (option.max_num_correspondences_ > 0 &&
+        static_cast<int>(corres.size()) > option.max_num_correspondences_) {
+        // Keep the most distinctive matches.
+        const std::vector<double> distances =
+                ComputeCorrespondenceFeatureDistances(
+                        source_features, target_features, corres);
+        std::vector<int> order(corres.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::nth_element(order.begin(),
+                         order.begin() + option.max_num_correspondences_,
+                         order.end(), [&](int a, int b) {
+                             return distances[a] < distances[b] ||
+                                    (distances[a] == distances[b] && a < b);
+                         });
+        order.resize(option.max_num_correspondences_);
+        std::sort(order.begin(), order.end());
+        CorrespondenceSet kept_corres(order.size());
+        for (size_t k = 0; k < order.size(); k++) {
+            kept_corres[k] = corres[order[k]];
+        }
+        corres = std::move(kept_corres);
+    }
+
+    return RegistrationMaxCliqueBasedOnCorrespondence(
+            source, target, corres, max_correspondence_distance, option);
+}
+
+}  // namespace registration
+}  // namespace pipelines
+}  // namespace tiny3d
@@ -0,0 +1,133 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <vector>
+
+#include "tiny3d/pipelines/registration/Registration.h"
+
+namespace tiny3d {
+
+namespace geometry {
+class PointCloud;
+}
+
+namespace pipelines {
+namespace registration {
+
+class Feature;
+
+/// \class MaxCliqueRegistrationOption
+///
+/// \brief Options for global registration based on the maximum clique of
+/// pairwise consistent correspondences.
+///
+/// The registration follows TEASER++ (Yang et al., "TEASER: Fast and
+/// Certifiable Point Cloud Registration", T-RO 2020): correspondences whose
+/// pairwise distances agree within the noise bound are connected in a graph,
+/// the maximum clique of the graph is taken as the inlier set, and scale,
+/// rotation and translation are then estimated with truncated least squares.
+class MaxCliqueRegistrationOption {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param with_scaling Estimate a uniform scale between source and target.
+    /// \param exact_max_clique Solve the maximum clique exactly. If false, a
+    /// greedy heuristic is used, which is faster but may miss inliers.
+    /// \param max_clique_time_limit Time limit in seconds for the exact
+    /// maximum clique search. The best clique found so far is used once the
+    /// limit is hit.
+    /// \param rotation_gnc_factor Factor the GNC control parameter grows by
+    /// in every rotation estimation iteration.
+    /// \param rotation_max_iteration Maximum number of GNC iterations of the
+    /// rotation estimation.
+    /// \param rotation_cost_threshold Change of the rotation cost, the
+    /// weighted sum of squared residuals, below which the GNC iterations stop.
+    /// \param max_num_correspondences Maximum number of correspondences the
+    /// consistency graph is built on, which is quadratic in their number.
+    /// Feature matching keeps the ones of lowest feature distance, given
+    /// correspondences are subsampled evenly. Zero or less keeps all.
+    MaxCliqueRegistrationOption(bool with_scaling = false,
+                                bool exact_max_clique = true,
+                                double max_clique_time_limit = 10.0,
+                                double rotation_gnc_factor = 1.4,
+                                int rotation_max_iteration = 100,
+                                double rotation_cost_threshold = 1e-6,
+                                int max_num_correspondences = 5000)
+        : with_scaling_(with_scaling),
+          exact_max_clique_(exact_max_clique),
+          max_clique_time_limit_(max_clique_time_limit),
+          rotation_gnc_factor_(rotation_gnc_factor),
+          rotation_max_iteration_(rotation_max_iteration),
+          rotation_cost_threshold_(rotation_cost_threshold),
+          max_num_correspondences_(max_num_correspondences) {}
+    ~MaxCliqueRegistrationOption() {}
+
+public:
+    /// Estimate a uniform scale between source and target.
+    bool with_scaling_;
+    /// Solve the maximum clique exactly instead of greedily.
+    bool exact_max_clique_;
+    /// Time limit in seconds for the exact maximum clique search.
+    double max_clique_time_limit_;
+    /// Factor the GNC control parameter grows by in every iteration.
+    double rotation_gnc_factor_;
+    /// Maximum number of GNC iterations of the rotation estimation.
+    int rotation_max_iteration_;
+    /// Change of the rotation cost below which GNC stops.
+    double rotation_cost_threshold_;
+    /// Maximum number of correspondences the consistency graph is built on.
+    int max_num_correspondences_;
+};
+
+/// \brief Function for global registration based on the maximum clique of a
+/// given set of correspondences.
+///
+/// Unlike RANSAC, the runtime only depends on the number of correspondences
+/// and on the time limit of the clique search, not on the outlier ratio.
+///
+/// \param source The source point cloud.
+/// \param target The target point cloud.
+/// \param corres Correspondence indices between source and target point clouds.
+/// \param max_correspondence_distance Maximum correspondence points-pair
+/// distance, used as the noise bound of inlier correspondences.
+/// \param option Registration option.
+RegistrationResult RegistrationMaxCliqueBasedOnCorrespondence(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres,
+        double max_correspondence_distance,
+        const MaxCliqueRegistrationOption &option =
+                MaxCliqueRegistrationOption());
+
+/// \brief Function for global registration based on the maximum clique of
+/// feature matching correspondences.
+///
+/// \param source The source point cloud.
+/// \param target The target point cloud.
+/// \param source_features Source point cloud feature.
+/// \param target_features Target point cloud feature.
+/// \param mutual_filter Enables mutual filter such that the correspondence of
+/// the source point's correspondence is itself.
+/// \param max_correspondence_distance Maximum correspondence points-pair
+/// distance, used as the noise bound of inlier correspondences.
+/// \param option Registration option.
+RegistrationResult RegistrationMaxCliqueBasedOnFeatureMatching(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const Feature &source_features,
+        const Feature &target_features,
+        bool mutual_filter,
+        double max_correspondence_distance,
+        const MaxCliqueRegistrationOption &option =
+                MaxCliqueRegistrationOption());
+
+}  // namespace registration
+}  // namespace pipelines
+}  // namespace tiny3d
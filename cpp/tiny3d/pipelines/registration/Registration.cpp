@@ -8,7 +8,12 @@
 #include "tiny3d/pipelines/registration/Registration.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
 
 #include "tiny3d/geometry/KDTreeFlann.h"
 #include "tiny3d/geometry/PointCloud.h"
@@ -21,68 +26,154 @@ namespace tiny3d {
 namespace pipelines {
 namespace registration {
 
-static RegistrationResult GetRegistrationResultAndCorrespondencesTransformedSource(
+namespace {
+
+/// \class ICPWorkspace
+///
+/// Reusable buffers for the correspondence search of ICP. The source points
+/// are split into a fixed number of blocks. The first pass records the nearest
+/// target of every source point and counts inliers per block, the second pass
+/// scatters the matches into the correspondence set at the prefix-sum offset
+/// of each block. Once the buffers have been sized in the first iteration, the
+/// following iterations do not allocate.
+class ICPWorkspace {
+public:
+    /// Searches the nearest target point of every transformed source point
+    /// and writes fitness, RMSE and (optionally) correspondences into
+    /// \p result, reusing the capacity of its correspondence set.
+    void ComputeRegistrationResult(const geometry::PointCloud &source,
+                                   const geometry::KDTreeFlann &target_kdtree,
+                                   double max_correspondence_distance,
+                                   const Eigen::Matrix4d &transformation,
+                                   bool with_correspondence_set,
+                                   RegistrationResult &result);
+
+private:
+    void Reserve(int n_source, bool with_correspondence_set);
+
+    int num_blocks_ = 0;
+    int block_size_ = 1;
+    std::vector<int> match_;
+    std::vector<size_t> block_offset_;
+    std::vector<double> block_error2_;
+    std::vector<std::vector<int>> block_indices_;
+    std::vector<std::vector<double>> block_dists_;
+};
+
+void ICPWorkspace::Reserve(int n_source, bool with_correspondence_set) {
+    if (num_blocks_ == 0) {
+        num_blocks_ = std::max(1, 4 * utility::EstimateMaxThreads());
+        block_offset_.resize(num_blocks_ + 1);
+        block_error2_.resize(num_blocks_);
+        block_indices_.resize(num_blocks_);
+        block_dists_.resize(num_blocks_);
+        for (int b = 0; b < num_blocks_; ++b) {
+            block_indices_[b].reserve(1);
+            block_dists_[b].reserve(1);
+        }
+    }
+    block_size_ = std::max(1, (n_source + num_blocks_ - 1) / num_blocks_);
+    if (with_correspondence_set && (int)match_.size() < n_source) {
+        match_.resize(n_source);
+    }
+}
+
+void ICPWorkspace::ComputeRegistrationResult(
         const geometry::PointCloud &source,
-        const geometry::PointCloud &target,
         const geometry::KDTreeFlann &target_kdtree,
         double max_correspondence_distance,
         const Eigen::Matrix4d &transformation,
-        bool with_correspondence_set = true) {
-    RegistrationResult result(transformation);
-    if (max_correspondence_distance <= 0.0) {
-        return result;
+        bool with_correspondence_set,
+        RegistrationResult &result) {
+    result.transformation_ = transformation;
+    result.correspondence_set_.clear();
+    result.fitness_ = 0.0;
+    result.inlier_rmse_ = 0.0;
+    if (max_correspondence_distance <= 0.0 || source.points_.empty()) {
+        return;
     }
 
+    const int n_source = static_cast<int>(source.points_.size());
+    Reserve(n_source, with_correspondence_set);
     const Eigen::Matrix3d R = transformation.block<3, 3>(0, 0);
     const Eigen::Vector3d t = transformation.block<3, 1>(0, 3);
 
-    double error2 = 0.0;
-    size_t correspondence_count = 0;
-#pragma omp parallel
-    {
-        double error2_private = 0.0;
-        int inlier_count_private = 0;
-        CorrespondenceSet correspondence_set_private;
-        std::vector<int> indices;
-        std::vector<double> dists;
-        indices.reserve(1);
-        dists.reserve(1);
-#pragma omp for nowait
-        for (int i = 0; i < (int)source.points_.size(); i++) {
+    // Pass 1: nearest neighbor of every source point, counted per block.
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int b = 0; b < num_blocks_; ++b) {
+        const int begin = std::min(n_source, b * block_size_);
+        const int end = std::min(n_source, begin + block_size_);
+        std::vector<int> &indices = block_indices_[b];
+        std::vector<double> &dists = block_dists_[b];
+        size_t count = 0;
+        double error2 = 0.0;
+        for (int i = begin; i < end; i++) {
             const Eigen::Vector3d point = R * source.points_[i] + t;
+            int match = -1;
             if (target_kdtree.SearchHybrid(point, max_correspondence_distance,
                                            1, indices, dists) > 0) {
-                error2_private += dists[0];
-                inlier_count_private++;
-                if (with_correspondence_set) {
-                    correspondence_set_private.emplace_back(i, indices[0]);
-                }
+                error2 += dists[0];
+                count++;
+                match = indices[0];
             }
-        }
-#pragma omp critical(GetRegistrationResultAndCorrespondencesTransformedSource)
-        {
             if (with_correspondence_set) {
-                result.correspondence_set_.insert(
-                        result.correspondence_set_.end(),
-                        correspondence_set_private.begin(),
-                        correspondence_set_private.end());
+                match_[i] = match;
             }
-            correspondence_count += static_cast<size_t>(inlier_count_private);
-            error2 += error2_private;
         }
+        block_offset_[b + 1] = count;
+        block_error2_[b] = error2;
     }
 
+    block_offset_[0] = 0;
+    double error2 = 0.0;
+    for (int b = 0; b < num_blocks_; ++b) {
+        block_offset_[b + 1] += block_offset_[b];
+        error2 += block_error2_[b];
+    }
+    const size_t correspondence_count = block_offset_[num_blocks_];
     if (correspondence_count == 0) {
-        result.fitness_ = 0.0;
-        result.inlier_rmse_ = 0.0;
-    } else {
-        result.fitness_ = source.points_.empty()
-                                  ? 0.0
-                                  : static_cast<double>(correspondence_count) /
-                                            static_cast<double>(source.points_.size());
-        result.inlier_rmse_ =
-                std::sqrt(error2 / static_cast<double>(correspondence_count));
+        return;
+    }
+    result.fitness_ = static_cast<double>(correspondence_count) /
+                      static_cast<double>(n_source);
+    result.inlier_rmse_ =
+            std::sqrt(error2 / static_cast<double>(correspondence_count));
+    if (!with_correspondence_set) {
+        return;
     }
+
+    // Pass 2: scatter the matches of each block at its prefix-sum offset.
+    if (result.correspondence_set_.capacity() < (size_t)n_source) {
+        result.correspondence_set_.reserve(n_source);
+    }
+    result.correspondence_set_.resize(correspondence_count);
+#pragma omp parallel for schedule(static)
+    for (int b = 0; b < num_blocks_; ++b) {
+        const int begin = std::min(n_source, b * block_size_);
+        const int end = std::min(n_source, begin + block_size_);
+        size_t k = block_offset_[b];
+        for (int i = begin; i < end; i++) {
+            if (match_[i] >= 0) {
+                result.correspondence_set_[k++] = Eigen::Vector2i(i, match_[i]);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+/// One-off evaluation with a temporary workspace. Loops keep an ICPWorkspace
+/// instead, so that its buffers are reused.
+static RegistrationResult GetRegistrationResultAndCorrespondencesTransformedSource(
+        const geometry::PointCloud &source,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &transformation) {
+    RegistrationResult result(transformation);
+    ICPWorkspace workspace;
+    workspace.ComputeRegistrationResult(source, target_kdtree,
+                                        max_correspondence_distance,
+                                        transformation, true, result);
     return result;
 }
 
@@ -336,6 +427,259 @@ static double EvaluateInlierCorrespondenceRatio(
                               : 0.0;
 }
 
+namespace {
+
+/// \class PackedCorrespondences
+///
+/// Source and target points of a correspondence set packed as a structure of
+/// arrays, so that RANSAC hypotheses can be scored by a vectorized count of
+/// inlier correspondences.
+class PackedCorrespondences {
+public:
+    PackedCorrespondences(const geometry::PointCloud &source,
+                          const geometry::PointCloud &target,
+                          const CorrespondenceSet &corres);
+
+    int Size() const { return static_cast<int>(sx_.size()); }
+
+    /// Counts the correspondences whose residual under \p transformation is
+    /// below the distance threshold. Returns early with a count lower than
+    /// \p min_count as soon as \p min_count can no longer be reached.
+    int CountInliers(const Eigen::Matrix4d &transformation,
+                     double max_distance2,
+                     int min_count) const;
+
+    /// Fills \p inlier_prefix such that inlier_prefix[i] is the number of
+    /// inliers under \p transformation among the first i + 1 correspondences.
+    void CountInlierPrefix(const Eigen::Matrix4d &transformation,
+                           double max_distance2,
+                           std::vector<int> &inlier_prefix) const;
+
+private:
+    std::vector<double> sx_, sy_, sz_;
+    std::vector<double> tx_, ty_, tz_;
+};
+
+PackedCorrespondences::PackedCorrespondences(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres)
+    : sx_(corres.size()),
+      sy_(corres.size()),
+      sz_(corres.size()),
+      tx_(corres.size()),
+      ty_(corres.size()),
+      tz_(corres.size()) {
+    for (size_t i = 0; i < corres.size(); ++i) {
+        const Eigen::Vector3d &ps = source.points_[corres[i](0)];
+        const Eigen::Vector3d &pt = target.points_[corres[i](1)];
+        sx_[i] = ps(0);
+        sy_[i] = ps(1);
+        sz_[i] = ps(2);
+        tx_[i] = pt(0);
+        ty_[i] = pt(1);
+        tz_[i] = pt(2);
+    }
+}
+
+int PackedCorrespondences::CountInliers(const Eigen::Matrix4d &transformation,
+                                        double max_distance2,
+                                        int min_count) const {
+    // Residuals are counted in blocks; the early exit is checked in between.
+    constexpr int kBlockSize = 256;
+    const double r00 = transformation(0, 0), r01 = transformation(0, 1),
+                 r02 = transformation(0, 2), t0 = transformation(0, 3);
+    const double r10 = transformation(1, 0), r11 = transformation(1, 1),
+                 r12 = transformation(1, 2), t1 = transformation(1, 3);
+    const double r20 = transformation(2, 0), r21 = transformation(2, 1),
+                 r22 = transformation(2, 2), t2 = transformation(2, 3);
+    const double *sx = sx_.data(), *sy = sy_.data(), *sz = sz_.data();
+    const double *tx = tx_.data(), *ty = ty_.data(), *tz = tz_.data();
+    const int n = Size();
+    int count = 0;
+    for (int begin = 0; begin < n; begin += kBlockSize) {
+        const int end = std::min(n, begin + kBlockSize);
+        int block_count = 0;
+#pragma omp simd reduction(+ : block_count)
+        for (int i = begin; i < end; ++i) {
+            const double dx = r00 * sx[i] + r01 * sy[i] + r02 * sz[i] + t0 - tx[i];
+            const double dy = r10 * sx[i] + r11 * sy[i] + r12 * sz[i] + t1 - ty[i];
+            const double dz = r20 * sx[i] + r21 * sy[i] + r22 * sz[i] + t2 - tz[i];
+            block_count += (dx * dx + dy * dy + dz * dz < max_distance2) ? 1 : 0;
+        }
+        count += block_count;
+        if (count + (n - end) < min_count) {
+            break;
+        }
+    }
+    return count;
+}
+
+void PackedCorrespondences::CountInlierPrefix(
+        const Eigen::Matrix4d &transformation,
+        double max_distance2,
+        std::vector<int> &inlier_prefix) const {
+    const int n = Size();
+    inlier_prefix.resize(n);
+    int count = 0;
+    for (int i = 0; i < n; ++i) {
+        const Eigen::Vector3d ps(sx_[i], sy_[i], sz_[i]);
+        const Eigen::Vector3d pt(tx_[i], ty_[i], tz_[i]);
+        const Eigen::Vector3d residual =
+                transformation.block<3, 3>(0, 0) * ps +
+                transformation.block<3, 1>(0, 3) - pt;
+        count += residual.squaredNorm() < max_distance2 ? 1 : 0;
+        inlier_prefix[i] = count;
+    }
+}
+
+/// A RANSAC hypothesis scored by its number of inlier correspondences.
+struct RANSACHypothesis {
+    int inlier_count;
+    /// Iteration that drew the hypothesis, which breaks ties.
+    int iteration;
+    Eigen::Matrix4d_u transformation;
+};
+
+/// A hypothesis that survived the pruning of its chunk, committed at the end
+/// of the RANSAC round.
+struct RANSACCandidate {
+    RANSACHypothesis hypothesis;
+    /// Iteration bound implied by the hypothesis should it become the best.
+    double est_k = std::numeric_limits<double>::infinity();
+    /// With RANSACScoring::PointCloud, the validation of the hypothesis.
+    RegistrationResult result;
+};
+
+/// Number of hypotheses that are validated against the point clouds at the
+/// end of a RANSAC run with RANSACScoring::Correspondence.
+constexpr int kRANSACNumFinalists = 4;
+
+/// Inserts \p hypothesis into \p finalists, which is kept sorted by
+/// decreasing inlier count, then increasing iteration, and holds at most
+/// kRANSACNumFinalists entries.
+void InsertRANSACFinalist(std::vector<RANSACHypothesis> &finalists,
+                          const RANSACHypothesis &hypothesis) {
+    auto it = std::upper_bound(finalists.begin(), finalists.end(), hypothesis,
+                               [](const RANSACHypothesis &a,
+                                  const RANSACHypothesis &b) {
+                                   return a.inlier_count > b.inlier_count ||
+                                          (a.inlier_count == b.inlier_count &&
+                                           a.iteration < b.iteration);
+                               });
+    finalists.insert(it, hypothesis);
+    if (static_cast<int>(finalists.size()) > kRANSACNumFinalists) {
+        finalists.pop_back();
+    }
+}
+
+/// Growth schedule of PROSAC (Chum and Matas, "Matching with PROSAC -
+/// Progressive Sample Consensus", CVPR 2005). Hypothesis t (1-based) is drawn
+/// from the SubsetSize(t) best correspondences and always contains the last of
+/// them. The schedule reaches all correspondences after about max_iteration
+/// hypotheses, after which sampling is uniform.
+class PROSACSchedule {
+public:
+    PROSACSchedule(int num_corres, int ransac_n, int max_iteration)
+        : ransac_n_(ransac_n), growth_(num_corres) {
+        // T_n: expected number of samples drawn from the n best
+        // correspondences out of max_iteration uniform samples.
+        double t_n = max_iteration;
+        for (int i = 0; i < ransac_n; i++) {
+            t_n *= static_cast<double>(ransac_n - i) /
+                   static_cast<double>(num_corres - i);
+        }
+        // T'_n: the hypothesis at which the subset grows to n.
+        int64_t t_n_prime = 1;
+        for (int n = 1; n <= num_corres; n++) {
+            if (n > ransac_n) {
+                const double t_n_next = t_n * n / (n - ransac_n);
+                t_n_prime += static_cast<int64_t>(std::ceil(t_n_next - t_n));
+                t_n = t_n_next;
+            }
+            growth_[n - 1] = static_cast<int>(std::min<int64_t>(
+                    t_n_prime, std::numeric_limits<int>::max()));
+        }
+    }
+
+    /// Returns the hypothesis at which the subset grows to the \p n best
+    /// correspondences.
+    int Growth(int n) const { return growth_[n - 1]; }
+
+    /// Returns the subset size hypothesis \p t is drawn from, or 0 once the
+    /// schedule is exhausted.
+    int SubsetSize(int t) const {
+        auto it = std::lower_bound(growth_.begin() + ransac_n_ - 1,
+                                   growth_.end(), t);
+        if (it == growth_.end()) return 0;
+        return static_cast<int>(it - growth_.begin()) + 1;
+    }
+
+private:
+    int ransac_n_;
+    std::vector<int> growth_;
+};
+
+}  // namespace
+
+/// Number of RANSAC iterations needed to draw an all-inlier sample with the
+/// desired confidence, given the correspondence inlier ratio.
+static double EstimateRANSACIterations(double inlier_ratio,
+                                       int ransac_n,
+                                       double confidence,
+                                       double current_estimate) {
+    const double inlier_prob = std::pow(inlier_ratio, ransac_n);
+    if (inlier_prob >= 1.0) {
+        return 1.0;
+    }
+    if (inlier_prob > 0.0) {
+        const double est_k =
+                std::log(1.0 - confidence) / std::log(1.0 - inlier_prob);
+        if (est_k >= 0.0 && std::isfinite(est_k)) {
+            return est_k;
+        }
+    }
+    return current_estimate;
+}
+
+/// PROSAC termination (Chum and Matas, 2005): the number of hypotheses after
+/// which, for some subset of the n best correspondences, the inliers of the
+/// best hypothesis within the subset are unlikely to be consistent by chance
+/// (non-randomness) and an all-inlier sample from the subset has been drawn
+/// with the desired confidence (maximality). \p inlier_prefix holds the
+/// inlier counts of the best hypothesis, see
+/// PackedCorrespondences::CountInlierPrefix().
+static double EstimatePROSACIterations(const PROSACSchedule &schedule,
+                                       const std::vector<int> &inlier_prefix,
+                                       int ransac_n,
+                                       double confidence,
+                                       double current_estimate) {
+    // Probability that an outlier correspondence is consistent with a wrong
+    // hypothesis, and the number of standard deviations the inliers beyond
+    // the sample have to exceed the chance level by.
+    constexpr double kRandomInlierProb = 0.05;
+    constexpr double kNonRandomnessSigma = 3.0;
+    double est_k = current_estimate;
+    for (int n = ransac_n; n <= static_cast<int>(inlier_prefix.size()); n++) {
+        const int inlier_count = inlier_prefix[n - 1];
+        const double trials = n - ransac_n;
+        const double random_mean = kRandomInlierProb * trials;
+        const double random_sigma = std::sqrt(
+                trials * kRandomInlierProb * (1.0 - kRandomInlierProb));
+        if (inlier_count - ransac_n <=
+            random_mean + kNonRandomnessSigma * random_sigma) {
+            continue;
+        }
+        const double k_n = EstimateRANSACIterations(
+                static_cast<double>(inlier_count) / n, ransac_n, confidence,
+                current_estimate);
+        if (k_n <= schedule.Growth(n)) {
+            est_k = std::min(est_k, k_n);
+        }
+    }
+    return est_k;
+}
+
 RegistrationResult EvaluateRegistration(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -345,7 +689,7 @@ RegistrationResult EvaluateRegistration(
     geometry::KDTreeFlann kdtree;
     kdtree.SetGeometry(target);
     return GetRegistrationResultAndCorrespondencesTransformedSource(
-            source, target, kdtree, max_correspondence_distance, transformation);
+            source, kdtree, max_correspondence_distance, transformation);
 }
 
 RegistrationResult RegistrationICP(
@@ -374,10 +718,13 @@ RegistrationResult RegistrationICP(
     geometry::KDTreeFlann kdtree;
     const geometry::PointCloud &target_initialized = *target_initialized_c;
     kdtree.SetGeometry(target_initialized);
+    // The workspace and the result's correspondence set are reused by every
+    // iteration, so the loop below does not allocate after the first search.
+    ICPWorkspace workspace;
     RegistrationResult result;
-    result = GetRegistrationResultAndCorrespondencesTransformedSource(
-            *source_initialized_c, target_initialized, kdtree,
-            max_correspondence_distance, transformation);
+    workspace.ComputeRegistrationResult(*source_initialized_c, kdtree,
+                                        max_correspondence_distance,
+                                        transformation, true, result);
     for (int i = 0; i < criteria.max_iteration_; i++) {
         utility::LogDebug("ICP Iteration #{:d}: Fitness {:.4f}, RMSE {:.4f}", i,
                           result.fitness_, result.inlier_rmse_);
@@ -391,13 +738,14 @@ RegistrationResult RegistrationICP(
             break;
         }
         transformation = update * transformation;
-        RegistrationResult backup = result;
-        result = GetRegistrationResultAndCorrespondencesTransformedSource(
-                *source_initialized_c, target_initialized, kdtree,
-                max_correspondence_distance, transformation);
-        if (std::abs(backup.fitness_ - result.fitness_) <
+        const double prev_fitness = result.fitness_;
+        const double prev_inlier_rmse = result.inlier_rmse_;
+        workspace.ComputeRegistrationResult(*source_initialized_c, kdtree,
+                                            max_correspondence_distance,
+                                            transformation, true, result);
+        if (std::abs(prev_fitness - result.fitness_) <
                     criteria.relative_fitness_ &&
-            std::abs(backup.inlier_rmse_ - result.inlier_rmse_) <
+            std::abs(prev_inlier_rmse - result.inlier_rmse_) <
                     criteria.relative_rmse_) {
             break;
         }
@@ -416,7 +764,9 @@ RegistrationResult RegistrationRANSACBasedOnCorrespondence(
         const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
                 &checkers /* = {}*/,
         const RANSACConvergenceCriteria &criteria
-        /* = RANSACConvergenceCriteria()*/) {
+        /* = RANSACConvergenceCriteria()*/,
+        RANSACScoring scoring /* = RANSACScoring::PointCloud*/,
+        RANSACSampling sampling /* = RANSACSampling::Uniform*/) {
     if (ransac_n < 3 || (int)corres.size() < ransac_n ||
         max_correspondence_distance <= 0.0) {
         return RegistrationResult();
@@ -427,145 +777,324 @@ RegistrationResult RegistrationRANSACBasedOnCorrespondence(
 
     RegistrationResult best_result;
     geometry::KDTreeFlann kdtree(target);
-    int est_k_global = criteria.max_iteration_;
-    int total_validation = 0;
+
+    // Iterations are handed out in chunks to balance the uneven cost of
+    // hypotheses that are rejected early and those that are validated.
+    constexpr int kIterationChunk = 64;
+    // Chunks run in rounds. Within a round, hypotheses are pruned against the
+    // state committed by the previous rounds and the earlier hypotheses of
+    // their own chunk. At the end of a round the chunks are committed in
+    // iteration order, which also lowers the iteration bound. The result thus
+    // depends on the seed and the number of threads, but not on how the
+    // chunks are scheduled. In exchange, threads only see each other's best
+    // and the lowered bound at the end of a round, so the first round has one
+    // chunk per thread and the rounds grow geometrically from there: easy
+    // inputs stop after a few chunks, hard ones commit rarely.
+    const int num_threads = std::max(1, utility::EstimateMaxThreads());
+    const int max_chunks_per_round = 4 * num_threads;
+    // Each chunk samples from its own random stream, so the hypotheses only
+    // depend on the global seed and the iteration index, not on which thread
+    // runs the chunk, and sampling never takes the global random mutex.
+    const uint64_t seed = utility::random::RandUint32();
+
+    // Committed state, only written between rounds.
+    int round_begin = 0;
+    int chunks_per_round = num_threads;
+    int est_k = criteria.max_iteration_;
+    // With RANSACScoring::Correspondence, the inlier count a hypothesis needs
+    // to enter the finalists.
+    int min_inlier_count = 1;
+    std::vector<std::vector<RANSACCandidate>> round_candidates(
+            max_chunks_per_round);
+    std::atomic<int> total_validation(0);
+
+    const bool score_correspondences = scoring == RANSACScoring::Correspondence;
+    std::unique_ptr<PackedCorrespondences> packed_corres;
+    if (score_correspondences) {
+        packed_corres = std::make_unique<PackedCorrespondences>(source, target,
+                                                                corres);
+    }
+    const double max_distance2 =
+            max_correspondence_distance * max_correspondence_distance;
+    std::vector<RANSACHypothesis> finalists;
+    std::unique_ptr<PROSACSchedule> prosac;
+    if (sampling == RANSACSampling::Progressive) {
+        prosac = std::make_unique<PROSACSchedule>(
+                static_cast<int>(corres.size()), ransac_n,
+                criteria.max_iteration_);
+    }
+    // Iteration bound implied by a hypothesis, should it become the best.
+    auto estimate_iterations = [&](double corres_inlier_ratio,
+                                   const Eigen::Matrix4d &transformation,
+                                   std::vector<int> &inlier_prefix) {
+        double est_k_d = EstimateRANSACIterations(
+                corres_inlier_ratio, ransac_n, criteria.confidence_,
+                criteria.max_iteration_);
+        if (prosac && score_correspondences) {
+            packed_corres->CountInlierPrefix(transformation, max_distance2,
+                                             inlier_prefix);
+            est_k_d = EstimatePROSACIterations(*prosac, inlier_prefix,
+                                               ransac_n, criteria.confidence_,
+                                               est_k_d);
+        }
+        return est_k_d;
+    };
 
 #pragma omp parallel
     {
         CorrespondenceSet ransac_corres(ransac_n);
-        RegistrationResult best_result_local;
-        int est_k_local = criteria.max_iteration_;
-        utility::random::UniformIntGenerator<int> rand_gen(0,
-                                                           corres.size() - 1);
+        // The hypotheses of a chunk are sampled and checked as one batch.
+        CorrespondenceSet block_corres;
+        std::vector<uint8_t> block_valid;
+        std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                block_transformations;
+        std::vector<int> inlier_prefix;
+        // Validation buffers, reused by all the hypotheses of the thread.
+        ICPWorkspace workspace;
+        RegistrationResult validation;
+        utility::random::LocalUniformIntGenerator<int> rand_gen(
+                0, static_cast<int>(corres.size()) - 1);
 
-#pragma omp for nowait
-        for (int itr = 0; itr < criteria.max_iteration_; itr++) {
-            if (itr < est_k_global) {
-                int sampled = 0;
-                int attempts = 0;
-                const int max_attempts = std::max(32 * ransac_n, 128);
-                while (sampled < ransac_n) {
-                    const auto &candidate = corres[rand_gen()];
-                    bool duplicated = false;
-                    for (int j = 0; j < sampled; ++j) {
-                        if (ransac_corres[j] == candidate) {
-                            duplicated = true;
-                            break;
+        // Every thread reads the committed state after the barrier that ends
+        // the previous round, so all threads leave the loop together.
+        while (round_begin < est_k) {
+#pragma omp for schedule(dynamic, 1)
+            for (int chunk = 0; chunk < chunks_per_round; chunk++) {
+                std::vector<RANSACCandidate> &candidates =
+                        round_candidates[chunk];
+                candidates.clear();
+                const int chunk_begin = round_begin + chunk * kIterationChunk;
+                const int chunk_end =
+                        std::min(chunk_begin + kIterationChunk, est_k);
+                if (chunk_begin >= chunk_end) {
+                    continue;
+                }
+                const int num_hypotheses = chunk_end - chunk_begin;
+                rand_gen.Seed(seed, chunk_begin / kIterationChunk);
+
+                block_corres.resize(static_cast<size_t>(num_hypotheses) *
+                                    ransac_n);
+                block_valid.assign(num_hypotheses, 1);
+                for (int h = 0; h < num_hypotheses; h++) {
+                    int sampled = 0;
+                    int sample_high = static_cast<int>(corres.size()) - 1;
+                    if (prosac) {
+                        const int subset_size =
+                                prosac->SubsetSize(chunk_begin + h + 1);
+                        if (subset_size > 0) {
+                            ransac_corres[sampled++] = corres[subset_size - 1];
+                            sample_high = subset_size - 2;
                         }
                     }
-                    if (!duplicated) {
-                        ransac_corres[sampled++] = candidate;
+                    int attempts = 0;
+                    const int max_attempts = std::max(32 * ransac_n, 128);
+                    while (sampled < ransac_n) {
+                        const auto &candidate =
+                                corres[rand_gen(0, sample_high)];
+                        bool duplicated = false;
+                        for (int j = 0; j < sampled; ++j) {
+                            if (ransac_corres[j] == candidate) {
+                                duplicated = true;
+                                break;
+                            }
+                        }
+                        if (!duplicated) {
+                            ransac_corres[sampled++] = candidate;
+                        }
+                        if (++attempts > max_attempts) {
+                            break;
+                        }
                     }
-                    if (++attempts > max_attempts) {
-                        break;
+                    if (sampled < ransac_n) {
+                        block_valid[h] = 0;
+                        continue;
                     }
-                }
-                if (sampled < ransac_n) {
-                    continue;
+                    std::copy(ransac_corres.begin(), ransac_corres.end(),
+                              block_corres.begin() + h * ransac_n);
                 }
 
-                Eigen::Matrix4d transformation =
-                        estimation.ComputeTransformation(source, target,
-                                                         ransac_corres);
-                if (!transformation.allFinite()) {
-                    continue;
-                }
-
-                // Check transformation: inexpensive
-                bool check = true;
+                // Checkers that do not depend on the transformation reject
+                // hypotheses before it is estimated.
+                block_transformations.clear();
                 for (const auto &checker : checkers) {
-                    if (!checker.get().Check(source, target, ransac_corres,
-                                             transformation)) {
-                        check = false;
-                        break;
+                    if (!checker.get().require_pointcloud_alignment_) {
+                        checker.get().CheckBatch(source, target, block_corres,
+                                                 ransac_n,
+                                                 block_transformations,
+                                                 block_valid);
                     }
                 }
-                if (!check) continue;
-
-                // Cheap validation pass; skip obviously weak candidates.
-                const auto sampled_result =
-                        GetRegistrationResultTransformedSourceSampled(
-                                source, target, kdtree,
-                                max_correspondence_distance, transformation,
-                                2048);
-                if (best_result_local.fitness_ > 0.0 &&
-                    sampled_result.fitness_ + 0.02 <
-                            best_result_local.fitness_) {
-                    continue;
+                block_transformations.resize(num_hypotheses);
+                for (int h = 0; h < num_hypotheses; h++) {
+                    if (!block_valid[h]) continue;
+                    std::copy(block_corres.begin() + h * ransac_n,
+                              block_corres.begin() + (h + 1) * ransac_n,
+                              ransac_corres.begin());
+                    block_transformations[h] = estimation.ComputeTransformation(
+                            source, target, ransac_corres);
+                    if (!block_transformations[h].allFinite()) {
+                        block_valid[h] = 0;
+                    }
                 }
-                if (sampled_result.fitness_ <= 0.0) {
-                    continue;
+                // Check transformation: inexpensive
+                for (const auto &checker : checkers) {
+                    if (checker.get().require_pointcloud_alignment_) {
+                        checker.get().CheckBatch(source, target, block_corres,
+                                                 ransac_n,
+                                                 block_transformations,
+                                                 block_valid);
+                    }
                 }
 
-                // Expensive validation
-                auto result =
-                        GetRegistrationResultAndCorrespondencesTransformedSource(
-                                source, target, kdtree,
-                                max_correspondence_distance, transformation,
-                                false);
-
-                if (result.IsBetterRANSACThan(best_result_local)) {
-                    result = GetRegistrationResultAndCorrespondencesTransformedSource(
-                            source, target, kdtree,
-                            max_correspondence_distance, transformation, true);
-                } else {
-                    continue;
-                }
+                // Best hypothesis of the chunk so far.
+                int chunk_best_count = 0;
+                RegistrationResult chunk_best;
+                for (int h = 0; h < num_hypotheses; h++) {
+                    if (!block_valid[h]) continue;
+                    const int itr = chunk_begin + h;
+                    const Eigen::Matrix4d &transformation =
+                            block_transformations[h];
 
-                if (result.IsBetterRANSACThan(best_result_local)) {
-                    best_result_local = result;
+                    if (score_correspondences) {
+                        // A hypothesis must beat the weakest finalist to
+                        // matter; on a tie the earlier finalist wins.
+                        const int inlier_count = packed_corres->CountInliers(
+                                transformation, max_distance2,
+                                min_inlier_count);
+                        total_validation.fetch_add(1,
+                                                   std::memory_order_relaxed);
+                        if (inlier_count < min_inlier_count) {
+                            continue;
+                        }
+                        RANSACCandidate candidate;
+                        candidate.hypothesis = {inlier_count, itr,
+                                                transformation};
+                        if (inlier_count > chunk_best_count) {
+                            chunk_best_count = inlier_count;
+                            candidate.est_k = estimate_iterations(
+                                    static_cast<double>(inlier_count) /
+                                            static_cast<double>(
+                                                    packed_corres->Size()),
+                                    transformation, inlier_prefix);
+                        }
+                        candidates.push_back(std::move(candidate));
+                        continue;
+                    }
+
+                    // Cheap validation pass; skip obviously weak candidates.
+                    const double best_fitness = std::max(
+                            chunk_best.fitness_, best_result.fitness_);
+                    const auto sampled_result =
+                            GetRegistrationResultTransformedSourceSampled(
+                                    source, target, kdtree,
+                                    max_correspondence_distance,
+                                    transformation, 2048);
+                    if (best_fitness > 0.0 &&
+                        sampled_result.fitness_ + 0.02 < best_fitness) {
+                        continue;
+                    }
+                    if (sampled_result.fitness_ <= 0.0) {
+                        continue;
+                    }
 
-                    double corres_inlier_ratio =
+                    // Expensive validation
+                    workspace.ComputeRegistrationResult(
+                            source, kdtree, max_correspondence_distance,
+                            transformation, false, validation);
+                    total_validation.fetch_add(1, std::memory_order_relaxed);
+
+                    // An earlier round already holds a strictly better
+                    // hypothesis.
+                    if (validation.fitness_ < best_result.fitness_ ||
+                        !validation.IsBetterRANSACThan(chunk_best)) {
+                        continue;
+                    }
+                    workspace.ComputeRegistrationResult(
+                            source, kdtree, max_correspondence_distance,
+                            transformation, true, validation);
+                    if (!validation.IsBetterRANSACThan(chunk_best)) {
+                        continue;
+                    }
+                    chunk_best.fitness_ = validation.fitness_;
+                    chunk_best.inlier_rmse_ = validation.inlier_rmse_;
+                    RANSACCandidate candidate;
+                    candidate.hypothesis = {0, itr, transformation};
+                    candidate.est_k = estimate_iterations(
                             EvaluateInlierCorrespondenceRatio(
                                     source, target, corres,
-                                    max_correspondence_distance, transformation);
-
-                    // Update exit condition if necessary
-                    double est_k_local_d = static_cast<double>(est_k_local);
-                    const double inlier_prob =
-                            std::pow(corres_inlier_ratio, ransac_n);
-                    if (inlier_prob >= 1.0) {
-                        est_k_local_d = 1.0;
-                    } else if (inlier_prob > 0.0) {
-                        est_k_local_d =
-                                std::log(1.0 - criteria.confidence_) /
-                                std::log(1.0 - inlier_prob);
-                        if (est_k_local_d < 0.0 || !std::isfinite(est_k_local_d)) {
-                            est_k_local_d = static_cast<double>(est_k_local);
-                        }
-                    }
-                    est_k_local =
-                            est_k_local_d < est_k_global
-                                    ? static_cast<int>(std::ceil(est_k_local_d))
-                                    : est_k_local;
-                    utility::LogDebug(
-                            "Thread {:06d}: registration fitness={:.3f}, "
-                            "corres inlier ratio={:.3f}, "
-                            "Est. max k = {}",
-                            itr, result.fitness_, corres_inlier_ratio,
-                            est_k_local_d);
+                                    max_correspondence_distance,
+                                    transformation),
+                            transformation, inlier_prefix);
+                    candidate.result = validation;
+                    candidates.push_back(std::move(candidate));
                 }
-#pragma omp critical
-                {
-                    total_validation += 1;
-                    if (est_k_local < est_k_global) {
-                        est_k_global = est_k_local;
+            }
+
+            // Commits the chunks in iteration order, as a sequential RANSAC
+            // would see their hypotheses.
+#pragma omp single
+            {
+                for (int chunk = 0; chunk < chunks_per_round; chunk++) {
+                    for (auto &candidate : round_candidates[chunk]) {
+                        const int itr = candidate.hypothesis.iteration;
+                        if (itr >= est_k) {
+                            break;
+                        }
+                        bool is_best;
+                        if (score_correspondences) {
+                            is_best = finalists.empty() ||
+                                      candidate.hypothesis.inlier_count >
+                                              finalists.front().inlier_count;
+                            InsertRANSACFinalist(finalists,
+                                                 candidate.hypothesis);
+                            if (static_cast<int>(finalists.size()) ==
+                                kRANSACNumFinalists) {
+                                min_inlier_count =
+                                        finalists.back().inlier_count + 1;
+                            }
+                        } else {
+                            is_best = candidate.result.IsBetterRANSACThan(
+                                    best_result);
+                            if (is_best) {
+                                best_result = std::move(candidate.result);
+                            }
+                        }
+                        if (is_best) {
+                            est_k = static_cast<int>(
+                                    std::min(std::ceil(candidate.est_k),
+                                             static_cast<double>(est_k)));
+                            utility::LogDebug(
+                                    "Iteration {:06d}: new best hypothesis, "
+                                    "Est. max k = {}",
+                                    itr, candidate.est_k);
+                        }
                     }
                 }
-            }  // if
-        }      // for loop
-
-#pragma omp critical(RegistrationRANSACBasedOnCorrespondence)
-        {
-            if (best_result_local.IsBetterRANSACThan(best_result)) {
-                best_result = best_result_local;
+                round_begin += chunks_per_round * kIterationChunk;
+                chunks_per_round =
+                        std::min(2 * chunks_per_round, max_chunks_per_round);
             }
         }
     }
+
+    // Only the best hypotheses by correspondence count are validated against
+    // the point clouds.
+    ICPWorkspace workspace;
+    RegistrationResult validation;
+    for (const auto &hypothesis : finalists) {
+        workspace.ComputeRegistrationResult(source, kdtree,
+                                            max_correspondence_distance,
+                                            hypothesis.transformation, true,
+                                            validation);
+        if (validation.IsBetterRANSACThan(best_result)) {
+            best_result = validation;
+        }
+    }
     utility::LogDebug(
             "RANSAC exits after {:d} validations. Best inlier ratio {:e}, "
             "RMSE {:e}",
-            total_validation, best_result.fitness_, best_result.inlier_rmse_);
+            total_validation.load(), best_result.fitness_,
+            best_result.inlier_rmse_);
     return best_result;
 }
 
@@ -582,17 +1111,35 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
         const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
                 &checkers /* = {}*/,
         const RANSACConvergenceCriteria
-                &criteria /* = RANSACConvergenceCriteria()*/) {
+                &criteria /* = RANSACConvergenceCriteria()*/,
+        RANSACScoring scoring /* = RANSACScoring::PointCloud*/,
+        RANSACSampling sampling /* = RANSACSampling::Uniform*/) {
     if (ransac_n < 3 || max_correspondence_distance <= 0.0) {
         return RegistrationResult();
     }
 
     CorrespondenceSet corres = CorrespondencesFromFeatures(
             source_features, target_features, mutual_filter);
+    if (sampling == RANSACSampling::Progressive) {
+        // Rank the correspondences by increasing feature distance.
+        const std::vector<double> distances =
+                ComputeCorrespondenceFeatureDistances(
+                        source_features, target_features, corres);
+        std::vector<int> order(corres.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return distances[a] < distances[b];
+        });
+        CorrespondenceSet sorted_corres(corres.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            sorted_corres[i] = corres[order[i]];
+        }
+        corres = std::move(sorted_corres);
+    }
 
     return RegistrationRANSACBasedOnCorrespondence(
             source, target, corres, max_correspondence_distance, estimation,
-            ransac_n, checkers, criteria);
+            ransac_n, checkers, criteria, scoring, sampling);
 }
 
 Eigen::Matrix6d GetInformationMatrixFromPointClouds(
@@ -603,8 +1150,8 @@ Eigen::Matrix6d GetInformationMatrixFromPointClouds(
     geometry::KDTreeFlann target_kdtree(target);
     RegistrationResult result =
             GetRegistrationResultAndCorrespondencesTransformedSource(
-                    source, target, target_kdtree,
-                    max_correspondence_distance, transformation);
+                    source, target_kdtree, max_correspondence_distance,
+                    transformation);
 
     // write q^*
     // see http://redwood-data.org/indoor/registration.html
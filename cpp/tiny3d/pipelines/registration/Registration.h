@@ -92,6 +92,35 @@ public:
     double confidence_;
 };
 
+/// \enum RANSACScoring
+///
+/// Selects how RANSAC scores the hypotheses that pass the correspondence
+/// checkers.
+enum class RANSACScoring {
+    /// Every hypothesis is validated with nearest neighbor searches between
+    /// the transformed source and the target point cloud.
+    PointCloud = 0,
+    /// Hypotheses are scored by counting inlier correspondences only, giving
+    /// up as soon as a hypothesis cannot beat the current best ones. The
+    /// nearest neighbor validation only runs on the final best hypotheses.
+    Correspondence = 1,
+};
+
+/// \enum RANSACSampling
+///
+/// Selects how RANSAC draws the correspondences of each hypothesis.
+enum class RANSACSampling {
+    /// Correspondences are drawn uniformly at random.
+    Uniform = 0,
+    /// PROSAC progressive sampling (Chum and Matas, 2005). The correspondences
+    /// must be sorted by decreasing quality. Hypotheses are drawn from a
+    /// growing set of the best correspondences, reaching all of them after
+    /// max_iteration_ hypotheses. With RANSACScoring::Correspondence, RANSAC
+    /// also stops early once the best hypothesis is confirmed within a subset
+    /// of the best correspondences.
+    Progressive = 1,
+};
+
 /// \class RegistrationResult
 ///
 /// Class that contains the registration results.
@@ -159,6 +188,10 @@ RegistrationResult RegistrationICP(
 /// \brief Function for global RANSAC registration based on a given set of
 /// correspondences.
 ///
+/// The result is reproducible: it only depends on the global seed, see
+/// utility::random::Seed(), and the number of threads, see
+/// utility::EstimateMaxThreads(), not on how the threads are scheduled.
+///
 /// \param source The source point cloud.
 /// \param target The target point cloud.
 /// \param corres Correspondence indices between source and target point clouds.
@@ -168,6 +201,9 @@ RegistrationResult RegistrationICP(
 /// \param ransac_n Fit ransac with `ransac_n` correspondences.
 /// \param checkers Correspondence checker.
 /// \param criteria Convergence criteria.
+/// \param scoring How hypotheses are scored, see RANSACScoring.
+/// \param sampling How hypotheses are sampled, see RANSACSampling. With
+/// RANSACSampling::Progressive, \p corres must be sorted by decreasing quality.
 RegistrationResult RegistrationRANSACBasedOnCorrespondence(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -178,8 +214,9 @@ RegistrationResult RegistrationRANSACBasedOnCorrespondence(
         int ransac_n = 3,
         const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
                 &checkers = {},
-        const RANSACConvergenceCriteria &criteria =
-                RANSACConvergenceCriteria());
+        const RANSACConvergenceCriteria &criteria = RANSACConvergenceCriteria(),
+        RANSACScoring scoring = RANSACScoring::PointCloud,
+        RANSACSampling sampling = RANSACSampling::Uniform);
 
 /// \brief Function for global RANSAC registration based on feature matching.
 ///
@@ -194,6 +231,10 @@ RegistrationResult RegistrationRANSACBasedOnCorrespondence(
 /// \param ransac_n Fit ransac with `ransac_n` correspondences.
 /// \param checkers Correspondence checker.
 /// \param criteria Convergence criteria.
+/// \param scoring How hypotheses are scored, see RANSACScoring.
+/// \param sampling How hypotheses are sampled, see RANSACSampling. With
+/// RANSACSampling::Progressive, correspondences are ranked by their feature
+/// distance.
 RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -206,8 +247,9 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
         int ransac_n = 3,
         const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
                 &checkers = {},
-        const RANSACConvergenceCriteria &criteria =
-                RANSACConvergenceCriteria());
+        const RANSACConvergenceCriteria &criteria = RANSACConvergenceCriteria(),
+        RANSACScoring scoring = RANSACScoring::PointCloud,
+        RANSACSampling sampling = RANSACSampling::Uniform);
 
 /// \param source The source point cloud.
 /// \param target The target point cloud.
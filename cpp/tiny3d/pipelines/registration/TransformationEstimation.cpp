@@ -8,6 +8,7 @@
 #include "tiny3d/pipelines/registration/TransformationEstimation.h"
 
 #include <Eigen/Geometry>
+#include <cmath>
 
 #include "tiny3d/geometry/PointCloud.h"
 #include "tiny3d/utility/Eigen.h"
@@ -29,12 +30,93 @@ double TransformationEstimationPointToPoint::ComputeRMSE(
     return std::sqrt(err / (double)corres.size());
 }
 
+/// Closed-form least squares alignment of a minimal sample of three
+/// correspondences, given as the columns of \p source and \p target. The
+/// centered points of both triangles are coplanar, so the optimal rotation
+/// maps the source plane onto the target plane and then solves the in-plane
+/// rotation in closed form, which avoids the SVD. Returns false for
+/// degenerate (collinear) samples.
+static bool ComputeTransformationMinimalPointToPoint(
+        const Eigen::Matrix3d &source,
+        const Eigen::Matrix3d &target,
+        bool with_scaling,
+        Eigen::Matrix4d &transformation) {
+    const Eigen::Vector3d mean_s = source.rowwise().mean();
+    const Eigen::Vector3d mean_t = target.rowwise().mean();
+    const Eigen::Matrix3d ds = source.colwise() - mean_s;
+    const Eigen::Matrix3d dt = target.colwise() - mean_t;
+
+    const Eigen::Vector3d normal_s = (ds.col(1) - ds.col(0))
+                                             .cross(ds.col(2) - ds.col(0));
+    const Eigen::Vector3d normal_t = (dt.col(1) - dt.col(0))
+                                             .cross(dt.col(2) - dt.col(0));
+    const double var_s = ds.squaredNorm();
+    const double var_t = dt.squaredNorm();
+    // Relative to the triangle sizes, so the test is scale invariant.
+    constexpr double kMinSine2 = 1e-12;
+    if (normal_s.squaredNorm() <= kMinSine2 * var_s * var_s ||
+        normal_t.squaredNorm() <= kMinSine2 * var_t * var_t) {
+        return false;
+    }
+
+    // The rotation either keeps the orientation of the triangle (normal_s to
+    // normal_t) or flips it over (normal_s to -normal_t); the best in-plane
+    // rotation of each is solved by a 2D Procrustes problem.
+    const Eigen::Vector3d axis_t = normal_t.normalized();
+    Eigen::Matrix3d best_rotation = Eigen::Matrix3d::Identity();
+    double best_score = -1.0;
+    for (const double orientation : {1.0, -1.0}) {
+        const Eigen::Vector3d axis = orientation * axis_t;
+        const Eigen::Matrix3d align =
+                Eigen::Quaterniond::FromTwoVectors(normal_s, axis)
+                        .toRotationMatrix();
+        const Eigen::Matrix3d aligned = align * ds;
+        double sine = 0.0, cosine = 0.0;
+        for (int i = 0; i < 3; i++) {
+            sine += aligned.col(i).cross(dt.col(i)).dot(axis);
+            cosine += aligned.col(i).dot(dt.col(i));
+        }
+        const double score = sine * sine + cosine * cosine;
+        if (score > best_score) {
+            best_score = score;
+            best_rotation =
+                    Eigen::AngleAxisd(std::atan2(sine, cosine), axis)
+                            .toRotationMatrix() *
+                    align;
+        }
+    }
+
+    double scale = 1.0;
+    if (with_scaling && var_s > 0.0) {
+        scale = std::sqrt(best_score) / var_s;
+    }
+    transformation.setIdentity();
+    transformation.block<3, 3>(0, 0) = scale * best_rotation;
+    transformation.block<3, 1>(0, 3) = mean_t - scale * best_rotation * mean_s;
+    return true;
+}
+
 Eigen::Matrix4d TransformationEstimationPointToPoint::ComputeTransformation(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
         const CorrespondenceSet &corres) const {
     if (corres.empty()) return Eigen::Matrix4d::Identity();
 
+    // Minimal samples, e.g. from RANSAC, take the closed-form solver.
+    if (corres.size() == 3) {
+        Eigen::Matrix3d source_points, target_points;
+        for (int i = 0; i < 3; i++) {
+            source_points.col(i) = source.points_[corres[i][0]];
+            target_points.col(i) = target.points_[corres[i][1]];
+        }
+        Eigen::Matrix4d transformation;
+        if (ComputeTransformationMinimalPointToPoint(
+                    source_points, target_points, with_scaling_,
+                    transformation)) {
+            return transformation;
+        }
+    }
+
     const double inv_n = 1.0 / static_cast<double>(corres.size());
     Eigen::Vector3d mean_s = Eigen::Vector3d::Zero();
     Eigen::Vector3d mean_t = Eigen::Vector3d::Zero();
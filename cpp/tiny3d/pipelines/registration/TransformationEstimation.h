@@ -81,6 +81,9 @@ public:
 /// \class TransformationEstimationPointToPoint
 ///
 /// Estimate a transformation for point to point distance.
+///
+/// Minimal samples of three correspondences, as drawn by RANSAC, are solved in
+/// closed form; larger sets use the SVD of the cross-covariance.
 class TransformationEstimationPointToPoint : public TransformationEstimation {
 public:
     /// \brief Parameterized Constructor.
@@ -0,0 +1,165 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#include "tiny3d/utility/Compression.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace tiny3d {
+namespace utility {
+
+// An LZF stream is a sequence of runs, each starting with a control byte c:
+// - c < 32: c + 1 literal bytes follow.
+// - otherwise, a back reference of length (c >> 5) + 2, extended by a second
+//   byte if c >> 5 is 7, to the data ((c & 31) << 8) + next byte + 1 bytes
+//   before the current output position.
+
+/// @cond
+namespace {
+
+constexpr size_t kLzfMaxLiteral = 32;
+constexpr size_t kLzfMaxOffset = 1 << 13;
+constexpr size_t kLzfMaxReference = (1 << 8) + (1 << 3);
+constexpr int kLzfHashLog = 14;
+
+inline uint32_t LzfHash(const uint8_t *p) {
+    const uint32_t v = (uint32_t(p[0]) << 16) | (uint32_t(p[1]) << 8) | p[2];
+    return (v * 2654435761u) >> (32 - kLzfHashLog);
+}
+
+}  // unnamed namespace
+/// @endcond
+
+size_t LzfMaxCompressedSize(size_t size) {
+    // One control byte per kLzfMaxLiteral literals in the worst case.
+    return size + size / kLzfMaxLiteral + 1;
+}
+
+size_t LzfCompress(const void *input,
+                   size_t input_size,
+                   void *output,
+                   size_t output_size) {
+    const uint8_t *in = static_cast<const uint8_t *>(input);
+    uint8_t *out = static_cast<uint8_t *>(output);
+    if (input_size == 0 || output_size == 0) {
+        return 0;
+    }
+    // Last position + 1 of every hashed 3 byte sequence, 0 if none.
+    std::vector<size_t> table(size_t(1) << kLzfHashLog, 0);
+    size_t ip = 0;
+    // The control byte of the current literal run is out[op - lit - 1].
+    size_t op = 1;
+    size_t lit = 0;
+    while (ip < input_size) {
+        if (ip + 2 < input_size) {
+            const uint32_t h = LzfHash(in + ip);
+            const size_t ref = table[h];
+            table[h] = ip + 1;
+            if (ref != 0 && ip - ref < kLzfMaxOffset &&
+                std::memcmp(in + ref - 1, in + ip, 3) == 0) {
+                const size_t offset = ip - ref;
+                const size_t max_length =
+                        std::min(input_size - ip, kLzfMaxReference);
+                size_t length = 3;
+                while (length < max_length &&
+                       in[ref - 1 + length] == in[ip + length]) {
+                    length++;
+                }
+                // Close the literal run, or drop its unused control byte.
+                if (lit > 0) {
+                    out[op - lit - 1] = static_cast<uint8_t>(lit - 1);
+                } else {
+                    op--;
+                }
+                // The reference takes 2 or 3 bytes. The control byte reserved
+                // after it is only written, and checked, by a later literal.
+                const size_t encoded = length - 2;
+                if (op + (encoded < 7 ? 2 : 3) > output_size) {
+                    return 0;
+                }
+                if (encoded < 7) {
+                    out[op++] = static_cast<uint8_t>((offset >> 8) |
+                                                     (encoded << 5));
+                } else {
+                    out[op++] = static_cast<uint8_t>((offset >> 8) | (7 << 5));
+                    out[op++] = static_cast<uint8_t>(encoded - 7);
+                }
+                out[op++] = static_cast<uint8_t>(offset & 0xff);
+                op++;
+                lit = 0;
+                ip += length;
+                continue;
+            }
+        }
+        if (op >= output_size) {
+            return 0;
+        }
+        out[op++] = in[ip++];
+        if (++lit == kLzfMaxLiteral) {
+            out[op - lit - 1] = static_cast<uint8_t>(lit - 1);
+            op++;
+            lit = 0;
+        }
+    }
+    if (lit > 0) {
+        out[op - lit - 1] = static_cast<uint8_t>(lit - 1);
+    } else {
+        op--;
+    }
+    return op;
+}
+
+size_t LzfDecompress(const void *input,
+                     size_t input_size,
+                     void *output,
+                     size_t output_size) {
+    const uint8_t *in = static_cast<const uint8_t *>(input);
+    uint8_t *out = static_cast<uint8_t *>(output);
+    size_t ip = 0;
+    size_t op = 0;
+    while (ip < input_size) {
+        const size_t ctrl = in[ip++];
+        if (ctrl < kLzfMaxLiteral) {
+            const size_t length = ctrl + 1;
+            if (ip + length > input_size || op + length > output_size) {
+                return 0;
+            }
+            std::memcpy(out + op, in + ip, length);
+            ip += length;
+            op += length;
+        } else {
+            size_t length = ctrl >> 5;
+            if (length == 7) {
+                if (ip >= input_size) {
+                    return 0;
+                }
+                length += in[ip++];
+            }
+            length += 2;
+            if (ip >= input_size) {
+                return 0;
+            }
+            const size_t offset = ((ctrl & 0x1f) << 8) + in[ip++] + 1;
+            if (offset > op || op + length > output_size) {
+                return 0;
+            }
+            // The reference may overlap the output, copy byte by byte.
+            const uint8_t *ref = out + op - offset;
+            for (size_t i = 0; i < length; i++) {
+                out[op + i] = ref[i];
+            }
+            op += length;
+        }
+    }
+    return op;
+}
+
+}  // namespace utility
+}  // namespace tiny3d
@@ -0,0 +1,37 @@
+// ----------------------------------------------------------------------------
+// -                        tiny3d: www.tiny3d.org                            -
+// ----------------------------------------------------------------------------
+// Copyright (c) 2018-2024 www.tiny3d.org
+// SPDX-License-Identifier: MIT
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+
+namespace tiny3d {
+namespace utility {
+
+/// Returns the size of an output buffer that is always large enough for the
+/// LZF compression of \p size bytes.
+size_t LzfMaxCompressedSize(size_t size);
+
+/// Compresses \p input_size bytes of \p input into \p output in the LZF
+/// format, as used by liblzf and by PCD binary_compressed data.
+/// \return The size of the compressed data, or 0 if it does not fit in
+/// \p output_size bytes or if \p input_size is 0.
+size_t LzfCompress(const void *input,
+                   size_t input_size,
+                   void *output,
+                   size_t output_size);
+
+/// Decompresses \p input_size bytes of LZF data of \p input into \p output.
+/// \return The size of the decompressed data, or 0 if the data is corrupted
+/// or does not fit in \p output_size bytes.
+size_t LzfDecompress(const void *input,
+                     size_t input_size,
+                     void *output,
+                     size_t output_size);
+
+}  // namespace utility
+}  // namespace tiny3d
@@ -22,6 +22,7 @@
 #endif
 #else
 #include <limits.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif
@@ -635,6 +636,105 @@ size_t CFile::ReadData(void *data, size_t elem_size, size_t num_elems) {
     return elems;
 }
 
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const std::string &filename) {
+    Close();
+    // Mappings of empty files are not allowed, they are represented by an
+    // empty buffer.
+    static const char empty[1] = {0};
+#ifdef WIN32
+    std::wstring filename_w;
+    filename_w.resize(filename.size());
+    int newSize = MultiByteToWideChar(CP_UTF8, 0, filename.c_str(),
+                                      static_cast<int>(filename.length()),
+                                      const_cast<wchar_t *>(filename_w.c_str()),
+                                      static_cast<int>(filename.length()));
+    filename_w.resize(newSize);
+    HANDLE file = CreateFileW(filename_w.c_str(), GENERIC_READ,
+                              FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        error_code_ = ENOENT;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        error_code_ = EIO;
+        CloseHandle(file);
+        return false;
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_ == 0) {
+        CloseHandle(file);
+        data_ = empty;
+        return true;
+    }
+    HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        error_code_ = EIO;
+        CloseHandle(file);
+        return false;
+    }
+    const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL) {
+        error_code_ = EIO;
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_handle_ = file;
+    mapping_handle_ = mapping;
+    data_ = static_cast<const char *>(data);
+#else
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_code_ = errno;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        error_code_ = errno;
+        close(fd);
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) {
+        close(fd);
+        data_ = empty;
+        return true;
+    }
+    void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+    if (data == MAP_FAILED) {
+        error_code_ = errno;
+        size_ = 0;
+        return false;
+    }
+    data_ = static_cast<const char *>(data);
+#endif
+    return true;
+}
+
+std::string MappedFile::GetError() { return GetIOErrorString(error_code_); }
+
+void MappedFile::Close() {
+    if (data_ && size_ > 0) {
+#ifdef WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_handle_);
+        CloseHandle(file_handle_);
+        mapping_handle_ = nullptr;
+        file_handle_ = nullptr;
+#else
+        munmap(const_cast<char *>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
 }  // namespace filesystem
 }  // namespace utility
 }  // namespace tiny3d
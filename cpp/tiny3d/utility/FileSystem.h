@@ -163,6 +163,45 @@ private:
     std::vector<char> line_buffer_;
 };
 
+/// RAII wrapper for a read-only memory mapping of a whole file.
+/// Large files can be decoded from the mapping directly, in parallel and
+/// without copying them into an intermediate buffer first.
+class MappedFile {
+public:
+    MappedFile() {}
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    /// The destructor unmaps the file automatically.
+    ~MappedFile();
+
+    /// Map a file. Returns false if the file cannot be opened or mapped.
+    bool Open(const std::string &filename);
+
+    /// Returns the last encountered error for this file.
+    std::string GetError();
+
+    /// Unmap the file.
+    void Close();
+
+    /// Returns true if a file is mapped.
+    bool IsOpen() const { return data_ != nullptr; }
+
+    /// Returns the mapped bytes, valid until the file is closed.
+    const char *GetData() const { return data_; }
+
+    /// Returns the file size in bytes.
+    size_t GetSize() const { return size_; }
+
+private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    int error_code_ = 0;
+#ifdef WIN32
+    void *file_handle_ = nullptr;
+    void *mapping_handle_ = nullptr;
+#endif
+};
+
 }  // namespace filesystem
 }  // namespace utility
 }  // namespace tiny3d
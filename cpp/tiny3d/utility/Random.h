@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <limits>
 #include <mutex>
 #include <random>
+#include <type_traits>
 
 #include "tiny3d/utility/Logging.h"
 
@@ -89,6 +92,156 @@ protected:
     std::uniform_int_distribution<T> distribution_;
 };
 
+/// PCG32 random engine (PCG-XSH-RR, 64-bit state, 32-bit output).
+///
+/// Unlike the global engine, a PCG32 engine is not protected by a mutex, each
+/// thread must own its engine. Engines constructed with the same seed and
+/// different stream ids produce independent sequences, which makes it possible
+/// to derive per-thread (or per-task) engines from one seed and to get
+/// reproducible results independent of scheduling. The output only depends on
+/// the seed and stream, not on the compiler or standard library.
+///
+/// Example:
+/// ```cpp
+/// #include "tiny3d/utility/Random.h"
+///
+/// // Derive the seed from the global engine once, outside parallel regions.
+/// const uint64_t seed = utility::random::RandUint32();
+/// #pragma omp parallel for
+/// for (int task = 0; task < num_tasks; ++task) {
+///     utility::random::PCG32 engine(seed, task);
+///     uint32_t value = engine();
+/// }
+/// ```
+class PCG32 {
+public:
+    using result_type = uint32_t;
+
+    /// \param seed Seed of the sequence.
+    /// \param stream Stream id; different streams give independent sequences.
+    explicit PCG32(uint64_t seed = 0, uint64_t stream = 0) {
+        Seed(seed, stream);
+    }
+
+    /// Restarts the engine at the beginning of the sequence of (seed, stream).
+    void Seed(uint64_t seed, uint64_t stream = 0) {
+        state_ = 0;
+        increment_ = (stream << 1u) | 1u;
+        (*this)();
+        state_ += seed;
+        (*this)();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /// Call this to generate a uniformly distributed uint32.
+    result_type operator()() {
+        const uint64_t old_state = state_;
+        state_ = old_state * 6364136223846793005ULL + increment_;
+        const uint32_t xor_shifted =
+                static_cast<uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+        const uint32_t rot = static_cast<uint32_t>(old_state >> 59u);
+        return (xor_shifted >> rot) | (xor_shifted << ((32u - rot) & 31u));
+    }
+
+private:
+    uint64_t state_;
+    uint64_t increment_;
+};
+
+/// Generate uniformly distributed random integers in [low, high] without
+/// locking.
+/// Unlike UniformIntGenerator, this class owns a PCG32 engine instead of using
+/// the global engine, so it must only be used by one thread at a time. It is
+/// meant for hot loops in parallel regions, with each thread (or task) seeded
+/// from a common seed and its own stream id. Integers are drawn with Lemire's
+/// nearly divisionless method, so the sequence is the same on all platforms.
+///
+/// Example:
+/// ```cpp
+/// #include "tiny3d/utility/Random.h"
+///
+/// const uint64_t seed = utility::random::RandUint32();
+/// #pragma omp parallel
+/// {
+///     utility::random::LocalUniformIntGenerator<int> gen(
+///             0, 100, seed, omp_get_thread_num());
+///     int value = gen();
+/// }
+/// ```
+template <typename T>
+class LocalUniformIntGenerator {
+    static_assert(std::is_integral<T>::value,
+                  "LocalUniformIntGenerator requires an integral type.");
+
+public:
+    /// Generate uniformly distributed random integer from
+    /// [low, low + 1, ... high].
+    ///
+    /// \param low The lower bound (inclusive).
+    /// \param high The upper bound (inclusive). \p high must be >= \p low and
+    /// \p high - \p low must fit in 32 bits.
+    /// \param seed Seed of the engine.
+    /// \param stream Stream id of the engine.
+    LocalUniformIntGenerator(const T low,
+                             const T high,
+                             uint64_t seed = 0,
+                             uint64_t stream = 0)
+        : low_(low), engine_(seed, stream) {
+        if (low > high) {
+            utility::LogError(
+                    "low must be <= high, but got low={} and high={}.", low,
+                    high);
+        }
+        const uint64_t span = static_cast<uint64_t>(high) -
+                              static_cast<uint64_t>(low);
+        if (span > std::numeric_limits<uint32_t>::max()) {
+            utility::LogError("high - low must fit in 32 bits, but got {}.",
+                              span);
+        }
+        range_ = span + 1;
+    }
+
+    /// Restarts the underlying engine, see PCG32::Seed().
+    void Seed(uint64_t seed, uint64_t stream = 0) {
+        engine_.Seed(seed, stream);
+    }
+
+    /// Call this to generate a uniformly distributed integer.
+    T operator()() { return Draw(low_, range_); }
+
+    /// Call this to generate a uniformly distributed integer in [low, high]
+    /// instead of the range given at construction, advancing the same engine.
+    /// \p high - \p low must fit in 32 bits.
+    T operator()(const T low, const T high) {
+        return Draw(low, static_cast<uint64_t>(high) -
+                                 static_cast<uint64_t>(low) + 1);
+    }
+
+protected:
+    T Draw(const T low, const uint64_t range) {
+        uint64_t m = static_cast<uint64_t>(engine_()) * range;
+        uint32_t l = static_cast<uint32_t>(m);
+        if (l < range) {
+            // Reject the few values that would bias the result.
+            const uint32_t threshold =
+                    static_cast<uint32_t>((uint64_t(1) << 32) % range);
+            while (l < threshold) {
+                m = static_cast<uint64_t>(engine_()) * range;
+                l = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<T>(static_cast<uint64_t>(low) + (m >> 32));
+    }
+
+    T low_;
+    uint64_t range_;
+    PCG32 engine_;
+};
+
 /// Generate uniformly distributed floating point values in [low, high).
 /// This class is globally seeded by utility::random::Seed().
 /// This class is a wrapper around std::uniform_real_distribution.